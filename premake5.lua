@@ -8,7 +8,7 @@ project "lmc"
 	cppdialect "C++17"
 	warnings "Extra"
 
-	links { "fmt" }
+	links { "fmt", "pthread" }
 
 	files { "src/**.hpp", "src/**.cpp" }
 
@@ -0,0 +1,105 @@
+/**
+ * @author ruarq
+ * @date 24.02.2022 
+ *
+ * Copyright (C) 2022 ruarq
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include "Arena.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <utility>
+
+namespace Lm
+{
+
+Arena::Arena(const size_t blockSize)
+	: blockSize(blockSize)
+{
+}
+
+Arena::Arena(Arena &&other)
+	: curr(other.curr)
+	, end(other.end)
+	, blockSize(other.blockSize)
+{
+	Absorb(std::move(other));
+}
+
+auto Arena::operator=(Arena &&other) -> Arena &
+{
+	if (this != &other)
+	{
+		blocks.clear();
+		used = reserved = allocations = 0;
+		curr = other.curr;
+		end = other.end;
+		blockSize = other.blockSize;
+		Absorb(std::move(other));
+	}
+
+	return *this;
+}
+
+auto Arena::Used() const -> size_t
+{
+	return used;
+}
+
+auto Arena::Reserved() const -> size_t
+{
+	return reserved;
+}
+
+auto Arena::Stats() const -> ArenaStats
+{
+	return { used, reserved, allocations, blocks.size() };
+}
+
+auto Arena::Absorb(Arena &&other) -> void
+{
+	// Only curr and end matter for new allocations, the order of the blocks doesn't
+	blocks.insert(blocks.end(),
+		std::make_move_iterator(other.blocks.begin()),
+		std::make_move_iterator(other.blocks.end()));
+
+	used += other.used;
+	reserved += other.reserved;
+	allocations += other.allocations;
+
+	other.blocks.clear();
+	other.curr = other.end = nullptr;
+	other.used = other.reserved = other.allocations = 0;
+}
+
+auto Arena::NewBlock(const size_t size) -> char *
+{
+	const auto n = std::max(size, blockSize);
+	blocks.emplace_back(new char[n]);
+	reserved += n;
+
+	curr = blocks.back().get();
+	end = curr + n;
+	return curr;
+}
+
+}
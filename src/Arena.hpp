@@ -0,0 +1,164 @@
+/**
+ * @author ruarq
+ * @date 24.02.2022 
+ *
+ * Copyright (C) 2022 ruarq
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Lm
+{
+
+/**
+ * @brief Memory usage of an arena
+ */
+struct ArenaStats final
+{
+	size_t used = 0;		   ///< Bytes handed out
+	size_t reserved = 0;	   ///< Bytes allocated from the system
+	size_t allocations = 0;	   ///< Number of Allocate() calls
+	size_t blocks = 0;		   ///< Number of blocks allocated from the system
+};
+
+/**
+ * @brief Bump allocator. Memory is handed out from large blocks and only released
+ * all at once when the arena is destroyed. Nothing allocated from it gets destructed.
+ */
+class Arena final
+{
+public:
+	static constexpr size_t defaultBlockSize = 64 * 1024;
+
+public:
+	Arena(const size_t blockSize = defaultBlockSize);
+	Arena(const Arena &) = delete;
+
+	/**
+	 * @brief Take over the blocks of other, other is empty afterwards
+	 */
+	Arena(Arena &&other);
+
+	auto operator=(const Arena &) -> Arena & = delete;
+
+	/**
+	 * @brief Release the own blocks and take over the ones of other, other is empty
+	 * afterwards
+	 */
+	auto operator=(Arena &&other) -> Arena &;
+
+public:
+	/**
+	 * @brief Get size bytes aligned to align, align has to be a power of two
+	 */
+	inline auto Allocate(const size_t size, const size_t align = alignof(std::max_align_t))
+		-> void *
+	{
+		auto ptr = Align(curr, align);
+		if (static_cast<size_t>(ptr - curr) + size > static_cast<size_t>(end - curr))
+		{
+			ptr = Align(NewBlock(size + align), align);
+		}
+
+		curr = ptr + size;
+		used += size;
+		++allocations;
+		return ptr;
+	}
+
+	/**
+	 * @brief Construct a T in the arena. The destructor of T never runs, so T has to
+	 * be trivially destructible.
+	 */
+	template<typename T, typename... Args>
+	inline auto New(Args &&...args) -> T *
+	{
+		static_assert(std::is_trivially_destructible_v<T>, "arenas don't run destructors");
+		return new (Allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+	}
+
+	/**
+	 * @brief Copy an array into the arena
+	 */
+	template<typename T>
+	inline auto Copy(const T *data, const size_t count) -> T *
+	{
+		static_assert(std::is_trivially_copyable_v<T>, "arena arrays are copied bytewise");
+		if (count == 0)
+		{
+			return nullptr;
+		}
+
+		auto copy = static_cast<T *>(Allocate(sizeof(T) * count, alignof(T)));
+		std::memcpy(copy, data, sizeof(T) * count);
+		return copy;
+	}
+
+	/**
+	 * @brief Bytes handed out so far
+	 */
+	auto Used() const -> size_t;
+
+	/**
+	 * @brief Bytes allocated from the system
+	 */
+	auto Reserved() const -> size_t;
+
+	auto Stats() const -> ArenaStats;
+
+	/**
+	 * @brief Take over the blocks of another arena, so everything allocated from it
+	 * lives as long as this arena. other is empty afterwards.
+	 */
+	auto Absorb(Arena &&other) -> void;
+
+private:
+	static inline auto Align(char *ptr, const size_t align) -> char *
+	{
+		const auto addr = reinterpret_cast<std::uintptr_t>(ptr);
+		return reinterpret_cast<char *>((addr + align - 1) & ~(align - 1));
+	}
+
+	/**
+	 * @brief Start a new block that can hold at least size bytes
+	 */
+	auto NewBlock(const size_t size) -> char *;
+
+private:
+	std::vector<std::unique_ptr<char[]>> blocks;
+	char *curr = nullptr;
+	char *end = nullptr;
+	size_t blockSize;
+	size_t used = 0;
+	size_t reserved = 0;
+	size_t allocations = 0;
+};
+
+}
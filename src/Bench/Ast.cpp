@@ -0,0 +1,358 @@
+/**
+ * @author ruarq
+ * @date 04.03.2022 
+ *
+ * Copyright (C) 2022 ruarq
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include "Ast.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+#include "../CompilationSession.hpp"
+#include "../Diagnostics.hpp"
+#include "../File.hpp"
+#include "../Lexer/Lexer.hpp"
+#include "../Localization/Locale.hpp"
+#include "../Logger.hpp"
+#include "../Parser/Ast/FlatTree.hpp"
+#include "../Parser/Parser.hpp"
+
+namespace Lm::Bench
+{
+
+namespace
+{
+
+/// Visit at least this many nodes per layout when timing
+constexpr size_t minVisits = 1 << 24;
+
+/**
+ * @brief What a pass over the tree computes, it touches every field of every node so
+ * neither walk can skip anything. Both layouts have to give the same result.
+ */
+struct Summary final
+{
+	size_t nodes = 0;
+	std::uint64_t checksum = 0;
+
+	inline auto Visit(const Ast::Kind kind, const SourcePos pos, const std::uint64_t data) -> void
+	{
+		++nodes;
+		checksum = (checksum ^ (static_cast<std::uint64_t>(kind) << 56) ^ pos.offset ^ (data << 24))
+			* 0x100000001b3;
+	}
+
+	inline auto operator==(const Summary &other) const -> bool
+	{
+		return nodes == other.nodes && checksum == other.checksum;
+	}
+};
+
+/**
+ * @brief Visit the nodes of a pointer tree in pre-order. The stack is reused between
+ * walks, expression trees are too deep to recurse on.
+ */
+/**
+ * @brief What the walks see of an expression node in a flat tree
+ */
+inline auto OperationData(const Ast::Kind kind, const Ast::FlatTree::Operation &operation)
+	-> std::uint64_t
+{
+	return kind == Ast::Kind::CastExpr ? operation.type.Id()
+									   : static_cast<std::uint64_t>(operation.op);
+}
+
+auto WalkPointers(const Ast::Node *root, std::vector<const Ast::Node *> &stack, Summary &summary)
+	-> void
+{
+	const auto pushList = [&stack](const Ast::List<Ast::Statement *> &list) {
+		for (auto i = list.Size(); i > 0; --i)
+		{
+			stack.push_back(list[i - 1]);
+		}
+	};
+
+	stack.push_back(root);
+	while (!stack.empty())
+	{
+		const auto node = stack.back();
+		stack.pop_back();
+		if (!node)
+		{
+			continue;
+		}
+
+		switch (node->kind)
+		{
+			case Ast::Kind::TranslationUnit:
+				summary.Visit(node->kind, node->pos, 0);
+				pushList(static_cast<const Ast::TranslationUnit *>(node)->statements);
+				break;
+
+			case Ast::Kind::FunctionDecl:
+			{
+				const auto fn = static_cast<const Ast::FunctionDecl *>(node);
+				summary.Visit(node->kind, node->pos, fn->ident.symbol.Id() ^ fn->type.Id());
+				stack.push_back(fn->statements);
+				break;
+			}
+
+			case Ast::Kind::StmtBlock:
+				summary.Visit(node->kind, node->pos, 0);
+				pushList(static_cast<const Ast::StmtBlock *>(node)->statements);
+				break;
+
+			case Ast::Kind::ReturnStmt:
+				summary.Visit(node->kind, node->pos, 0);
+				stack.push_back(static_cast<const Ast::ReturnStmt *>(node)->expr);
+				break;
+
+			case Ast::Kind::Int32Expr:
+				summary.Visit(node->kind,
+					node->pos,
+					static_cast<const Ast::Int32Expr *>(node)->value);
+				break;
+
+			case Ast::Kind::Identifier:
+				summary.Visit(node->kind,
+					node->pos,
+					static_cast<const Ast::Identifier *>(node)->symbol.Id());
+				break;
+
+			case Ast::Kind::UnaryExpr:
+			{
+				const auto unaryExpr = static_cast<const Ast::UnaryExpr *>(node);
+				summary.Visit(node->kind, node->pos, static_cast<std::uint64_t>(unaryExpr->op));
+				stack.push_back(unaryExpr->operand);
+				break;
+			}
+
+			case Ast::Kind::BinaryExpr:
+			{
+				const auto binaryExpr = static_cast<const Ast::BinaryExpr *>(node);
+				summary.Visit(node->kind, node->pos, static_cast<std::uint64_t>(binaryExpr->op));
+				stack.push_back(binaryExpr->rhs);
+				stack.push_back(binaryExpr->lhs);
+				break;
+			}
+
+			case Ast::Kind::CastExpr:
+			{
+				const auto castExpr = static_cast<const Ast::CastExpr *>(node);
+				summary.Visit(node->kind, node->pos, castExpr->type.Id());
+				stack.push_back(castExpr->expr);
+				break;
+			}
+		}
+	}
+}
+
+/**
+ * @brief Same walk as WalkPointers, following child indices in place of pointers
+ */
+auto WalkFlat(const Ast::FlatTree &tree, std::vector<Ast::node_index_t> &stack, Summary &summary)
+	-> void
+{
+	stack.push_back(0);
+	while (!stack.empty())
+	{
+		const auto node = stack.back();
+		stack.pop_back();
+		if (node == Ast::noNode)
+		{
+			continue;
+		}
+
+		const auto kind = tree.kinds[node];
+		const auto pos = tree.positions[node];
+		switch (kind)
+		{
+			case Ast::Kind::TranslationUnit:
+			case Ast::Kind::StmtBlock:
+			{
+				summary.Visit(kind, pos, 0);
+				const auto children = tree.Children(node);
+				for (auto i = children.Size(); i > 0; --i)
+				{
+					stack.push_back(children[i - 1]);
+				}
+				break;
+			}
+
+			case Ast::Kind::FunctionDecl:
+			{
+				const auto &fn = tree.GetFunction(node);
+				summary.Visit(kind, pos, fn.ident.Id() ^ fn.type.Id());
+				stack.push_back(fn.body);
+				break;
+			}
+
+			case Ast::Kind::ReturnStmt:
+				summary.Visit(kind, pos, 0);
+				stack.push_back(tree.payloads[node]);
+				break;
+
+			case Ast::Kind::Int32Expr:
+			case Ast::Kind::Identifier:
+				summary.Visit(kind, pos, tree.payloads[node]);
+				break;
+
+			case Ast::Kind::UnaryExpr:
+			case Ast::Kind::BinaryExpr:
+			case Ast::Kind::CastExpr:
+			{
+				const auto &operation = tree.GetOperation(node);
+				summary.Visit(kind, pos, OperationData(kind, operation));
+				stack.push_back(operation.rhs);
+				stack.push_back(operation.lhs);
+				break;
+			}
+		}
+	}
+}
+
+/**
+ * @brief Visit the nodes of a flat tree in index order, which is the order of the
+ * walks, with a single loop over the arrays
+ */
+auto ScanFlat(const Ast::FlatTree &tree, Summary &summary) -> void
+{
+	for (Ast::node_index_t node = 0; node < tree.Size(); ++node)
+	{
+		const auto kind = tree.kinds[node];
+		switch (kind)
+		{
+			case Ast::Kind::FunctionDecl:
+			{
+				const auto &fn = tree.GetFunction(node);
+				summary.Visit(kind, tree.positions[node], fn.ident.Id() ^ fn.type.Id());
+				break;
+			}
+
+			case Ast::Kind::Int32Expr:
+			case Ast::Kind::Identifier:
+				summary.Visit(kind, tree.positions[node], tree.payloads[node]);
+				break;
+
+			case Ast::Kind::UnaryExpr:
+			case Ast::Kind::BinaryExpr:
+			case Ast::Kind::CastExpr:
+				summary.Visit(kind,
+					tree.positions[node],
+					OperationData(kind, tree.GetOperation(node)));
+				break;
+
+			default: summary.Visit(kind, tree.positions[node], 0); break;
+		}
+	}
+}
+
+/**
+ * @brief Run a pass often enough to visit minVisits nodes
+ * @return Nanoseconds per visited node
+ */
+template<typename Pass>
+auto NsPerNode(const size_t nodes, Summary &summary, const Pass &pass) -> double
+{
+	const auto rounds = minVisits / std::max<size_t>(nodes, 1) + 1;
+
+	const auto start = std::chrono::high_resolution_clock::now();
+	for (size_t round = 0; round < rounds; ++round)
+	{
+		summary = Summary();
+		pass(summary);
+	}
+	const auto end = std::chrono::high_resolution_clock::now();
+
+	const auto ns = std::chrono::duration<double, std::nano>(end - start).count();
+	return ns / (double)(rounds * std::max<size_t>(nodes, 1));
+}
+
+}
+
+auto Ast(const std::vector<std::string> &filenames, const std::uint64_t seed) -> void
+{
+	CompilationSession session(seed);
+
+	for (const auto &filename : filenames)
+	{
+		File file(filename);
+		if (!file.Buf())
+		{
+			const auto error =
+				file.TooLarge() ? "FATAL_FILE_TOO_LARGE" : "FATAL_NO_SUCH_FILE_OR_DIRECTORY";
+			Logger::Error(Locale::Get(error), filename);
+			continue;
+		}
+
+		Diagnostics diagnostics(file);
+		Lexer<> lexer(file, diagnostics, session.Hasher());
+		Parser parser(lexer, diagnostics, session);
+		const auto unit = parser.Run();
+
+		const auto convertStart = std::chrono::high_resolution_clock::now();
+		const auto tree = Ast::FlatTree::FromTree(*unit);
+		const auto convertEnd = std::chrono::high_resolution_clock::now();
+		const auto convert = std::chrono::duration<double, std::nano>(convertEnd - convertStart);
+
+		Summary pointers;
+		Summary flat;
+		Summary scan;
+		std::vector<const Ast::Node *> pointerStack;
+		std::vector<Ast::node_index_t> flatStack;
+		const auto pointerNs = NsPerNode(tree.Size(), pointers, [&](Summary &summary) {
+			WalkPointers(unit, pointerStack, summary);
+		});
+		const auto flatNs = NsPerNode(tree.Size(), flat, [&](Summary &summary) {
+			WalkFlat(tree, flatStack, summary);
+		});
+		const auto scanNs = NsPerNode(tree.Size(), scan, [&tree](Summary &summary) {
+			ScanFlat(tree, summary);
+		});
+
+		if (!(pointers == flat) || !(pointers == scan))
+		{
+			Logger::Error("{}: the layouts disagree", file.Name());
+		}
+
+		Logger::Info("{}: - {} nodes - pointer tree {:.1f} KiB - flat tree {:.1f} KiB - "
+					 "convert {:.2f} ns/node",
+			file.Name(),
+			tree.Size(),
+			(double)unit->arena.Stats().used / 1024.0,
+			(double)tree.Bytes() / 1024.0,
+			convert.count() / (double)std::max<size_t>(tree.Size(), 1));
+		Logger::Info("{}: - pointer walk {:.2f} ns/node - flat walk {:.2f} ns/node - "
+					 "flat scan {:.2f} ns/node",
+			file.Name(),
+			pointerNs,
+			flatNs,
+			scanNs);
+
+		delete unit;
+	}
+}
+
+}
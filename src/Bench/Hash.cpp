@@ -0,0 +1,270 @@
+/**
+ * @author ruarq
+ * @date 28.02.2022 
+ *
+ * Copyright (C) 2022 ruarq
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include "Hash.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <unordered_set>
+
+#include "../Diagnostics.hpp"
+#include "../File.hpp"
+#include "../Hashes/Crc32cHash.hpp"
+#include "../Hashes/MurmurHash.hpp"
+#include "../Hashes/WyHash.hpp"
+#include "../Lexer/Lexer.hpp"
+#include "../Logger.hpp"
+#include "../SharedInterner.hpp"
+
+namespace Lm::Bench
+{
+
+namespace
+{
+
+/// Hash at least this many identifiers per policy when timing
+constexpr size_t minHashes = 1 << 23;
+
+/**
+ * @brief The identifiers of the input files, as they appear in them
+ */
+struct Corpus final
+{
+	std::vector<std::unique_ptr<File>> files;
+	std::vector<std::string_view> occurrences;
+	std::vector<std::string_view> distinct;
+	size_t bytes = 0;
+};
+
+auto LoadCorpus(const std::vector<std::string> &filenames) -> Corpus
+{
+	Corpus corpus;
+	const DefaultHash hasher;
+
+	for (const auto &filename : filenames)
+	{
+		auto file = std::make_unique<File>(filename);
+		if (!file->Buf())
+		{
+			const auto error =
+				file->TooLarge() ? "FATAL_FILE_TOO_LARGE" : "FATAL_NO_SUCH_FILE_OR_DIRECTORY";
+			Logger::Error(Locale::Get(error), filename);
+			continue;
+		}
+
+		Diagnostics diagnostics(*file);
+		Lexer<> lexer(*file, diagnostics, hasher);
+		for (auto token = lexer.NextToken(); token.type != Token::Type::Eof;
+			 token = lexer.NextToken())
+		{
+			if (token.type == Token::Type::Ident)
+			{
+				corpus.occurrences.push_back(lexer.Text(token));
+			}
+		}
+
+		corpus.bytes += file->Size();
+		corpus.files.push_back(std::move(file));
+	}
+
+	std::unordered_set<std::string_view> seen(corpus.occurrences.begin(),
+		corpus.occurrences.end());
+	corpus.distinct.assign(seen.begin(), seen.end());
+
+	return corpus;
+}
+
+/**
+ * @brief Log how long the identifiers are
+ */
+auto Describe(const Corpus &corpus) -> void
+{
+	size_t buckets[4] = {};
+	size_t total = 0;
+	for (const auto &ident : corpus.occurrences)
+	{
+		total += ident.size();
+		buckets[ident.size() <= 4 ? 0 : ident.size() <= 8 ? 1 : ident.size() <= 16 ? 2 : 3]++;
+	}
+
+	const auto Percent = [&](const size_t n) {
+		return 100.0 * (double)n / (double)corpus.occurrences.size();
+	};
+
+	Logger::Info("{} identifiers, {} distinct, {:.1f} bytes on average",
+		corpus.occurrences.size(),
+		corpus.distinct.size(),
+		(double)total / (double)corpus.occurrences.size());
+	Logger::Info("sizes: - 1-4 {:.1f}% - 5-8 {:.1f}% - 9-16 {:.1f}% - 17+ {:.1f}%",
+		Percent(buckets[0]),
+		Percent(buckets[1]),
+		Percent(buckets[2]),
+		Percent(buckets[3]));
+}
+
+template<typename HashPolicy>
+auto NsPerHash(const Corpus &corpus, const HashPolicy &hash) -> double
+{
+	const auto rounds = minHashes / corpus.occurrences.size() + 1;
+
+	// Fold the hashes into something observable, so the loop isn't optimized away
+	std::uint64_t sink = 0;
+
+	const auto start = std::chrono::high_resolution_clock::now();
+	for (size_t round = 0; round < rounds; ++round)
+	{
+		for (const auto &ident : corpus.occurrences)
+		{
+			sink += hash(ident);
+		}
+	}
+	const auto end = std::chrono::high_resolution_clock::now();
+
+	const auto ns = std::chrono::duration<double, std::nano>(end - start).count();
+	return sink == 1 ? 0.0 : ns / (double)(rounds * corpus.occurrences.size());
+}
+
+/**
+ * @brief Count the distinct identifiers whose home slot in an interner table of the
+ * same size is taken by another one. Compared against the number a perfectly random
+ * hash would give.
+ */
+template<typename HashPolicy>
+auto SlotCollisions(const Corpus &corpus, const HashPolicy &hash) -> std::pair<double, double>
+{
+	// Same sizing as the interner, a power of two at a load factor of at most 3/4
+	size_t slots = 1024;
+	while (corpus.distinct.size() * 4 > slots * 3)
+	{
+		slots *= 2;
+	}
+
+	std::vector<bool> used(slots);
+	size_t collisions = 0;
+	for (const auto &ident : corpus.distinct)
+	{
+		const auto slot = static_cast<std::uint32_t>(hash(ident)) & (slots - 1);
+		collisions += used[slot];
+		used[slot] = true;
+	}
+
+	const auto n = (double)corpus.distinct.size();
+	const auto m = (double)slots;
+	const auto expected = n - m * (1.0 - std::pow(1.0 - 1.0 / m, n));
+
+	return { 100.0 * (double)collisions / n, 100.0 * expected / n };
+}
+
+/**
+ * @brief Count the pairs of distinct identifiers with the same 32 bit hash, the part
+ * the interner caches
+ */
+template<typename HashPolicy>
+auto HashCollisions(const Corpus &corpus, const HashPolicy &hash) -> size_t
+{
+	std::vector<std::uint32_t> hashes;
+	hashes.reserve(corpus.distinct.size());
+	for (const auto &ident : corpus.distinct)
+	{
+		hashes.push_back(static_cast<std::uint32_t>(hash(ident)));
+	}
+
+	std::sort(hashes.begin(), hashes.end());
+	return hashes.size() - (std::unique(hashes.begin(), hashes.end()) - hashes.begin());
+}
+
+/**
+ * @brief Lex every file and intern its identifiers into a fresh interner, with the
+ * hash the lexer computed for every identifier
+ * @return The best MiB/s of a few runs
+ */
+template<typename HashPolicy>
+auto LexAndIntern(const Corpus &corpus, const HashPolicy &hash) -> double
+{
+	double best = 0.0;
+	for (int run = 0; run < 5; ++run)
+	{
+		SharedInterner<HashPolicy> interner({}, hash);
+
+		const auto start = std::chrono::high_resolution_clock::now();
+		for (const auto &file : corpus.files)
+		{
+			Diagnostics diagnostics(*file);
+			Lexer<HashPolicy> lexer(*file, diagnostics, hash);
+			for (auto token = lexer.NextToken(); token.type != Token::Type::Eof;
+				 token = lexer.NextToken())
+			{
+				if (token.type == Token::Type::Ident)
+				{
+					interner.Intern(lexer.Text(token), token.hash);
+				}
+			}
+		}
+		const auto end = std::chrono::high_resolution_clock::now();
+
+		const auto seconds = std::chrono::duration<double>(end - start).count();
+		best = std::max(best, (double)corpus.bytes / (seconds * (double)(1 << 20)));
+	}
+	return best;
+}
+
+template<typename HashPolicy>
+auto Measure(const Corpus &corpus, const HashPolicy &hash) -> void
+{
+	const auto [collisions, expected] = SlotCollisions(corpus, hash);
+	Logger::Info("{}: - {:.2f} ns/hash - slot collisions {:.2f}% (random {:.2f}%) - "
+				 "32 bit collisions {} - lex + intern {:.2f} MiB/s",
+		HashPolicy::name,
+		NsPerHash(corpus, hash),
+		collisions,
+		expected,
+		HashCollisions(corpus, hash),
+		LexAndIntern(corpus, hash));
+}
+
+}
+
+auto Hash(const std::vector<std::string> &filenames, const std::uint64_t seed) -> void
+{
+	const auto corpus = LoadCorpus(filenames);
+	if (corpus.occurrences.empty())
+	{
+		Logger::Error(Locale::Get("BENCH_ERROR_NO_IDENTIFIERS"));
+		return;
+	}
+
+	Describe(corpus);
+	Logger::Info("crc32c: {}", Crc32cHash::Hardware() ? "sse4.2" : "table");
+
+	Measure(corpus, MurmurHash(seed));
+	Measure(corpus, WyHash(seed));
+	Measure(corpus, Crc32cHash(seed));
+}
+
+}
@@ -0,0 +1,201 @@
+/**
+ * @author ruarq
+ * @date 25.02.2022 
+ *
+ * Copyright (C) 2022 ruarq
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include "Intern.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "../Logger.hpp"
+#include "../SharedInterner.hpp"
+
+namespace Lm::Bench
+{
+
+namespace
+{
+
+constexpr size_t distinctStrings = 1 << 16;
+constexpr size_t internsPerRun = 1 << 22;
+
+/**
+ * @brief Deterministic random numbers, the benchmark should do the same work every run
+ */
+struct Random final
+{
+	std::uint64_t state;
+
+	auto Next() -> std::uint64_t
+	{
+		state = state * 6364136223846793005ull + 1442695040888963407ull;
+		return state >> 33;
+	}
+};
+
+/**
+ * @brief Identifier like strings of 1 to 24 characters
+ */
+auto MakeStrings() -> std::vector<std::string>
+{
+	static constexpr std::string_view chars =
+		"abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789_";
+
+	Random random{ 1 };
+	std::vector<std::string> strings;
+	strings.reserve(distinctStrings);
+
+	for (size_t i = 0; i < distinctStrings; ++i)
+	{
+		// The index makes every string unique
+		auto str = std::to_string(i);
+		const auto length = 1 + random.Next() % 24;
+		while (str.size() < length)
+		{
+			str.insert(str.begin(), chars[random.Next() % (chars.size() - 10)]);
+		}
+		str.insert(str.begin(), chars[random.Next() % 52]);
+		strings.push_back(std::move(str));
+	}
+
+	return strings;
+}
+
+/**
+ * @brief Let threads threads intern internsPerRun strings from order in total
+ * @return Seconds it took
+ */
+auto Run(SharedInterner<> &interner,
+	const std::vector<std::string> &strings,
+	const std::vector<std::uint32_t> &order,
+	const size_t threads) -> double
+{
+	const auto start = std::chrono::high_resolution_clock::now();
+
+	std::vector<std::thread> workers;
+	for (size_t t = 0; t < threads; ++t)
+	{
+		workers.emplace_back([&, t] {
+			// Every thread starts at a different point of the same sequence
+			auto i = t * order.size() / threads;
+			for (size_t n = 0; n < internsPerRun / threads; ++n)
+			{
+				interner.Intern(strings[order[i]]);
+				i = (i + 1) % order.size();
+			}
+		});
+	}
+
+	for (auto &worker : workers)
+	{
+		worker.join();
+	}
+
+	const auto end = std::chrono::high_resolution_clock::now();
+	return std::chrono::duration<double>(end - start).count();
+}
+
+/**
+ * @brief Check that every string got exactly one id and maps back to itself
+ */
+auto Verify(SharedInterner<> &interner, const std::vector<std::string> &strings) -> bool
+{
+	if (interner.Size() != strings.size())
+	{
+		return false;
+	}
+
+	for (const auto &str : strings)
+	{
+		if (interner.Get(interner.Intern(str)) != str)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+}
+
+auto Intern(const size_t maxThreads, const std::uint64_t seed) -> void
+{
+	const auto strings = MakeStrings();
+
+	Random random{ 2 };
+	std::vector<std::uint32_t> order(internsPerRun / 4);
+	for (auto &index : order)
+	{
+		index = static_cast<std::uint32_t>(random.Next() % strings.size());
+	}
+
+	// Make sure every string gets interned by the first run
+	for (size_t i = 0; i < strings.size(); ++i)
+	{
+		order[i * order.size() / strings.size()] = static_cast<std::uint32_t>(i);
+	}
+
+	Logger::Info("interning {} strings, {} distinct", internsPerRun, strings.size());
+
+	// Powers of two and maxThreads itself
+	std::vector<size_t> threadCounts;
+	for (size_t threads = 1; threads < maxThreads; threads *= 2)
+	{
+		threadCounts.push_back(threads);
+	}
+	threadCounts.push_back(maxThreads);
+
+	double base = 0.0;
+	for (const auto threads : threadCounts)
+	{
+		// The first run inserts, the second one only finds interned strings
+		SharedInterner<> interner({}, DefaultHash(seed));
+		const auto insert = Run(interner, strings, order, threads);
+		const auto lookup = Run(interner, strings, order, threads);
+
+		if (!Verify(interner, strings))
+		{
+			Logger::Error("interner lost or duplicated strings with {} threads", threads);
+			return;
+		}
+
+		const auto mops = (double)internsPerRun / (lookup * 1e6);
+		if (threads == 1)
+		{
+			base = mops;
+		}
+
+		Logger::Info("{} thread(s): - insert {:.2f} Mops/s - lookup {:.2f} Mops/s - {:.2f}x",
+			threads,
+			(double)internsPerRun / (insert * 1e6),
+			mops,
+			mops / base);
+	}
+}
+
+}
@@ -0,0 +1,127 @@
+/**
+ * @author ruarq
+ * @date 27.02.2022 
+ *
+ * Copyright (C) 2022 ruarq
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <array>
+#include <string_view>
+
+#include "Lexer/Token.hpp"
+#include "Symbol.hpp"
+
+/**
+ * @brief Symbols the compiler knows about before it reads any file. Their ids are
+ * reserved by every CompilationSession in the order of "names", so they are
+ * compile time constants and checking for them is an integer compare.
+ */
+namespace Lm::Builtin
+{
+
+// clang-format off
+constexpr std::array<std::string_view, 15> names = {
+	"__void",
+	"i8",
+	"i16",
+	"i32",
+	"i64",
+	"u8",
+	"u16",
+	"u32",
+	"u64",
+	"f32",
+	"f64",
+	"bool",
+	"char",
+	"long",
+	"ulong",
+};
+// clang-format on
+
+/**
+ * @brief Get the symbol of a builtin by name, only meant for defining the constants below
+ */
+constexpr auto Get(const std::string_view name) -> Symbol
+{
+	for (symbol_id_t id = 0; id < names.size(); ++id)
+	{
+		if (names[id] == name)
+		{
+			return Symbol(id);
+		}
+	}
+	return Symbol();
+}
+
+constexpr auto voidType = Get("__void");	///< Type of functions without a return type
+constexpr auto int8 = Get("i8");
+constexpr auto int16 = Get("i16");
+constexpr auto int32 = Get("i32");
+constexpr auto int64 = Get("i64");
+constexpr auto uint8 = Get("u8");
+constexpr auto uint16 = Get("u16");
+constexpr auto uint32 = Get("u32");
+constexpr auto uint64 = Get("u64");
+constexpr auto float32 = Get("f32");
+constexpr auto float64 = Get("f64");
+constexpr auto boolType = Get("bool");
+constexpr auto charType = Get("char");
+constexpr auto longType = Get("long");
+constexpr auto ulongType = Get("ulong");
+
+/**
+ * @return True if the symbol is one of the builtins
+ */
+constexpr auto Is(const Symbol symbol) -> bool
+{
+	return symbol.Id() < names.size();
+}
+
+/**
+ * @brief Get the builtin type named by a type keyword
+ * @return An invalid symbol if the token isn't a type keyword
+ */
+constexpr auto FromToken(const Token::Type type) -> Symbol
+{
+	switch (type)
+	{
+		case Token::Type::Int8: return int8;
+		case Token::Type::Int16: return int16;
+		case Token::Type::Int32: return int32;
+		case Token::Type::Int64: return int64;
+		case Token::Type::UInt8: return uint8;
+		case Token::Type::UInt16: return uint16;
+		case Token::Type::UInt32: return uint32;
+		case Token::Type::UInt64: return uint64;
+		case Token::Type::Float32: return float32;
+		case Token::Type::Float64: return float64;
+		case Token::Type::Bool: return boolType;
+		case Token::Type::Char: return charType;
+		case Token::Type::Long: return longType;
+		case Token::Type::ULong: return ulongType;
+		default: return Symbol();
+	}
+}
+
+}
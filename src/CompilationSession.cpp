@@ -0,0 +1,93 @@
+/**
+ * @author ruarq
+ * @date 26.02.2022 
+ *
+ * Copyright (C) 2022 ruarq
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include "CompilationSession.hpp"
+
+#include "Builtins.hpp"
+
+namespace Lm
+{
+
+CompilationSession::CompilationSession(const std::uint64_t seed)
+	: seed(seed)
+	, symbols(std::vector<std::string_view>(Builtin::names.begin(), Builtin::names.end()),
+		  DefaultHash(seed))
+{
+}
+
+auto CompilationSession::Intern(const std::string_view str) -> Symbol
+{
+	const auto id = symbols.Intern(str);
+	return id == notInterned ? Symbol() : Symbol(id);
+}
+
+auto CompilationSession::Intern(const std::string_view str, const std::uint32_t hash) -> Symbol
+{
+	const auto id = symbols.Intern(str, hash);
+	return id == notInterned ? Symbol() : Symbol(id);
+}
+
+auto CompilationSession::Find(const std::string_view str) const -> Symbol
+{
+	const auto id = symbols.Find(str);
+	return id == notInterned ? Symbol() : Symbol(id);
+}
+
+auto CompilationSession::String(const Symbol symbol) const -> std::string_view
+{
+	return symbols.Get(symbol.Id());
+}
+
+auto CompilationSession::Symbols() const -> size_t
+{
+	return symbols.Size();
+}
+
+auto CompilationSession::SymbolStats() const -> TableStats
+{
+	return symbols.Stats();
+}
+
+auto CompilationSession::Seed() const -> std::uint64_t
+{
+	return seed;
+}
+
+auto CompilationSession::Hasher() const -> const DefaultHash &
+{
+	return symbols.Hasher();
+}
+
+auto CompilationSession::Freeze() -> void
+{
+	symbols.Freeze();
+}
+
+auto CompilationSession::Frozen() const -> bool
+{
+	return symbols.Frozen();
+}
+
+}
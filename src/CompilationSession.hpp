@@ -0,0 +1,110 @@
+/**
+ * @author ruarq
+ * @date 26.02.2022 
+ *
+ * Copyright (C) 2022 ruarq
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+#include "SharedInterner.hpp"
+#include "Symbol.hpp"
+
+namespace Lm
+{
+
+/**
+ * @brief State shared by every file compiled in one invocation of lmc.
+ *
+ * Owns the symbol table, so identifiers that show up in several files are only
+ * stored and hashed once. After the front end is done with every file the table
+ * gets frozen into a compact read only form for the rest of the compilation.
+ *
+ * The builtin symbols (see Builtins.hpp) are in the symbol table from the start.
+ */
+class CompilationSession final
+{
+public:
+	/**
+	 * @brief seed is the seed of the symbol table hash, see Seed.hpp
+	 */
+	explicit CompilationSession(const std::uint64_t seed);
+	CompilationSession(const CompilationSession &) = delete;
+
+	auto operator=(const CompilationSession &) -> CompilationSession & = delete;
+
+public:
+	/**
+	 * @brief Get the symbol of a string, adds the string to the symbol table if it's new.
+	 * Safe to call from multiple threads, returns an invalid symbol once frozen.
+	 */
+	auto Intern(const std::string_view str) -> Symbol;
+
+	/**
+	 * @brief Same as Intern(str), with the hash of str already computed through
+	 * Hasher(). The lexer hashes identifiers while it scans them (see Token::hash).
+	 */
+	auto Intern(const std::string_view str, const std::uint32_t hash) -> Symbol;
+
+	/**
+	 * @brief Get the symbol of a string without adding it
+	 * @return An invalid symbol if the string isn't in the symbol table
+	 */
+	auto Find(const std::string_view str) const -> Symbol;
+
+	/**
+	 * @brief Get the string of a symbol
+	 */
+	auto String(const Symbol symbol) const -> std::string_view;
+
+	/**
+	 * @brief Number of symbols
+	 */
+	auto Symbols() const -> size_t;
+
+	/**
+	 * @brief Measure the symbol hash table, only available before freezing
+	 */
+	auto SymbolStats() const -> TableStats;
+
+	auto Seed() const -> std::uint64_t;
+
+	/**
+	 * @brief The hash function of the symbol table
+	 */
+	auto Hasher() const -> const DefaultHash &;
+
+	/**
+	 * @brief End of the front end, no new symbols can be added after this
+	 */
+	auto Freeze() -> void;
+
+	auto Frozen() const -> bool;
+
+private:
+	std::uint64_t seed;
+	SharedInterner<> symbols;
+};
+
+}
@@ -30,48 +30,55 @@ namespace Lm
 
 Diagnostics::Diagnostics(const File &file)
 	: file(file)
+	, lines(file.Buf(), file.Size())
+	, buffer(Logger::Redirected())
 {
 }
 
 auto Diagnostics::Error(const SourcePos &where, const std::string &what) const -> void
 {
-	LM_DEBUG("{} {} {}", where.line, where.column, where.offset);
-	const auto line = LoadLine(where);
-	fmt::print("{} {} {}\n{}\n",
+	// A thread that collects the output of its part of the file (see ParseParallel,
+	// TokenPipe) comes first, then the thread that created the diagnostics
+	const auto out = Logger::Redirected() ? Logger::Redirected() : buffer;
+	const auto Write = [out](const std::string &text) {
+		if (out)
+		{
+			out->Append(text);
+		}
+		else
+		{
+			fmt::print("{}", text);
+		}
+	};
+
+	const auto pos = lines.Resolve(where);
+#ifdef DEBUG
+	Write(Logger::DebugText("{} {} {}", pos.line, pos.column, where.offset));
+#endif
+	const auto line = LoadLine(pos.line);
+
+	const auto text = fmt::format("{} {} {}\n{}\n{}",
 		fmt::format(fmt::fg(fmt::color::red) | fmt::emphasis::bold, "{}:", Locale::Get("ERROR")),
-		fmt::format(fmt::emphasis::bold, "{}:{}:{}:", file.Name(), where.line, where.column),
+		fmt::format(fmt::emphasis::bold, "{}:{}:{}:", file.Name(), pos.line, pos.column),
 		what,
-		line);
+		line,
+		Here(line, pos.column - 1, pos.column - 1, '^', '~'));
 
-	Here(line, where.column - 1, where.column - 1, '^', '~');
+	// One print per diagnostic, stdio locks the stream for each call, so diagnostics
+	// from different threads don't interleave
+	Write(text);
 }
 
-auto Diagnostics::LoadLine(const SourcePos &pos) const -> std::string
+auto Diagnostics::LoadLine(const line_t line) const -> std::string
 {
-	auto start = file.Buf() + pos.offset - 1;
-	auto end = start + 1;
-
-	// find the start of the line
-	while (*start != '\n' && start >= file.Buf())
-	{
-		--start;
-	}
-	++start;
-
-	// find the end of the line
-	while (*end != '\n' && end < file.Buf() + file.Size())
-	{
-		++end;
-	}
-
-	return std::string(start, end);
+	return std::string(lines.Line(line));
 }
 
 auto Diagnostics::Here(const std::string &line,
 	const column_t from,
 	const column_t to,
 	const char pointer,
-	const char underline) const -> void
+	const char underline) const -> std::string
 {
 	std::string pre;
 	for (column_t i = 0; i < from; ++i)
@@ -99,7 +106,7 @@ auto Diagnostics::Here(const std::string &line,
 		}
 	}
 
-	fmt::print(fmt::fg(fmt::color::green_yellow), "{}{}{}\n", pre, pointer, post);
+	return fmt::format(fmt::fg(fmt::color::green_yellow), "{}{}{}\n", pre, pointer, post);
 }
 
 }
@@ -30,6 +30,7 @@
 
 #include "File.hpp"
 #include "Lexer/Token.hpp"
+#include "LineIndex.hpp"
 #include "Localization/Locale.hpp"
 #include "Logger.hpp"
 
@@ -46,13 +47,15 @@ class Diagnostics final
 {
 public:
 	/**
-	 * @brief Initialize a diagnostics object for a file
+	 * @brief Initialize a diagnostics object for a file. The errors go where the
+	 * reporting thread logs to (see Logger::Redirect), or else where the constructing
+	 * thread logs to.
 	 */
 	Diagnostics(const File &file);
 
 public:
 	/**
-	 * @brief Emit a error message
+	 * @brief Emit a error message. Safe to call from multiple threads.
 	 */
 	auto Error(const SourcePos &where, const std::string &what) const -> void;
 
@@ -60,19 +63,21 @@ private:
 	/**
 	 * @brief Load a line in from the file buffer
 	 */
-	auto LoadLine(const SourcePos &pos) const -> std::string;
+	auto LoadLine(const line_t line) const -> std::string;
 
 	/**
-	 * @brief Helper function
+	 * @brief Helper function, returns the marker line below the source line
 	 */
 	auto Here(const std::string &line,
 		const column_t from,
 		const column_t to,
 		const char pointer,
-		const char underline) const -> void;
+		const char underline) const -> std::string;
 
 private:
 	const File &file;
+	LineIndex lines;
+	LogBuffer *buffer;
 };
 
 }
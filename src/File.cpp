@@ -25,38 +25,72 @@
 
 #include "File.hpp"
 
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "Lexer/Token.hpp"
 #include "Logger.hpp"
 
 namespace Lm
 {
 
-File::File(const std::string &filename)
+File::File(const std::string &filename, const LoadMode mode)
 	: name(filename)
 	, buf(nullptr)
+	, size(0)
+	, mapSize(0)
 {
-	file = fopen(filename.c_str(), "r");
-	if (!file)
+	const int fd = open(filename.c_str(), O_RDONLY);
+	if (fd < 0)
 	{
 		LM_DEBUG("Couldn't open file '{}'", filename);
 		return;
 	}
 
-	fseek(file, 0, SEEK_END);
-	size = ftell(file);
-	rewind(file);
+	struct stat info;
+	if (fstat(fd, &info) != 0 || !S_ISREG(info.st_mode))
+	{
+		LM_DEBUG("Couldn't stat file '{}'", filename);
+		close(fd);
+		return;
+	}
+
+	// Offsets into the file are 32 bit (see SourcePos), the eof token sits at the offset
+	// of the size
+	if ((std::uintmax_t)info.st_size >= std::numeric_limits<offset_t>::max())
+	{
+		LM_DEBUG("File '{}' is too large", filename);
+		tooLarge = true;
+		close(fd);
+		return;
+	}
+
+	size = info.st_size;
+
+	if (mode != LoadMode::Map || !Map(fd))
+	{
+		Read(fd);
+	}
 
-	buf = new char[size];
-	fread(buf, sizeof(char), size, file);
+	close(fd);
 }
 
 File::~File()
 {
-	if (buf)
+	if (mapSize)
+	{
+		munmap(buf, mapSize);
+	}
+	else if (buf)
 	{
 		delete[] buf;
 	}
-
-	fclose(file);
 }
 
 auto File::Buf() const -> const char *
@@ -74,4 +108,87 @@ auto File::Size() const -> size_t
 	return size;
 }
 
+auto File::Mapped() const -> bool
+{
+	return mapSize != 0;
+}
+
+auto File::TooLarge() const -> bool
+{
+	return tooLarge;
+}
+
+auto File::Prefault() const -> void
+{
+	if (!mapSize)
+	{
+		return;
+	}
+
+	// Volatile, so the reads happen even though nothing uses them
+	const volatile char *content = buf;
+	const size_t pageSize = sysconf(_SC_PAGESIZE);
+	for (size_t offset = 0; offset < size; offset += pageSize)
+	{
+		content[offset];
+	}
+}
+
+auto File::Map(const int fd) -> bool
+{
+	const size_t pageSize = sysconf(_SC_PAGESIZE);
+	const size_t length = (size + LM_FILE_PADDING + pageSize - 1) / pageSize * pageSize;
+
+	// Reserve the whole range as anonymous (zero filled) memory first, then map the file
+	// over the front of it. Everything after the last byte of the file reads as '\0',
+	// even if the size of the file is a multiple of the page size.
+	void *base = mmap(nullptr, length, PROT_READ, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if (base == MAP_FAILED)
+	{
+		return false;
+	}
+
+	if (size > 0)
+	{
+		void *content = mmap(base, size, PROT_READ, MAP_PRIVATE | MAP_FIXED, fd, 0);
+		if (content == MAP_FAILED)
+		{
+			munmap(base, length);
+			return false;
+		}
+
+		madvise(content, size, MADV_SEQUENTIAL);
+		madvise(content, size, MADV_WILLNEED);
+	}
+
+	buf = static_cast<char *>(base);
+	mapSize = length;
+	return true;
+}
+
+auto File::Read(const int fd) -> void
+{
+	buf = new char[size + LM_FILE_PADDING];
+	std::memset(buf + size, 0, LM_FILE_PADDING);
+
+	size_t done = 0;
+	while (done < size)
+	{
+		const auto n = read(fd, buf + done, size - done);
+		if (n <= 0)
+		{
+			LM_DEBUG("Couldn't read file '{}'", name);
+			break;
+		}
+		done += n;
+	}
+
+	// The file shrunk while reading, keep the guarantee of a NUL padded tail
+	if (done < size)
+	{
+		std::memset(buf + done, 0, size - done);
+		size = done;
+	}
+}
+
 }
@@ -25,7 +25,7 @@
 
 #pragma once
 
-#include <cstdio>
+#include <cstddef>
 #include <string>
 
 #include "Macros.hpp"
@@ -35,15 +35,33 @@ namespace Lm
 
 /**
  * @brief Simple file information
+ *
+ * The buffer is always followed by at least LM_FILE_PADDING NUL bytes,
+ * so Buf()[Size()] is guaranteed to be '\0' and reading a few bytes past
+ * the end of the content is safe.
  */
 class File final
 {
+public:
+	/**
+	 * @brief Defines how the content of a file gets loaded
+	 */
+	enum class LoadMode
+	{
+		Read,	 ///< Copy the content into a heap buffer
+		Map		 ///< Map the file into memory (zero-copy), falls back to Read on failure
+	};
+
 public:
 	/**
 	 * @brief Load from file
 	 * @param filename The name of the file
+	 * @param mode How the file should be loaded
 	 */
-	File(const std::string &filename);
+	File(const std::string &filename, const LoadMode mode = LoadMode::Map);
+
+	File(const File &) = delete;
+	auto operator=(const File &) -> File & = delete;
 
 	~File();
 
@@ -55,12 +73,44 @@ public:
 	auto Name() const -> std::string;
 	auto Size() const -> size_t;
 
+	/**
+	 * @return True if the buffer is a memory mapping of the file
+	 */
+	auto Mapped() const -> bool;
+
+	/**
+	 * @return True if the file wasn't loaded because token offsets can't address it
+	 */
+	auto TooLarge() const -> bool;
+
+	/**
+	 * @brief Touch every page of a mapped file, so reading it later doesn't wait for
+	 * the disk. Nothing to do for a file that was read.
+	 */
+	auto Prefault() const -> void;
+
+private:
+	/**
+	 * @brief Map the file into memory, with an anonymous zero page tail
+	 * @return True if mapping was successful
+	 */
+	auto Map(const int fd) -> bool;
+
+	/**
+	 * @brief Read the file into a heap buffer
+	 */
+	auto Read(const int fd) -> void;
+
 private:
-	FILE *file;
 	std::string name;
 
 	char *buf;
 	size_t size;
+
+	/// Length of the mapping, 0 if the buffer was allocated with new[]
+	size_t mapSize;
+
+	bool tooLarge = false;
 };
 
 }
@@ -0,0 +1,132 @@
+/**
+ * @author ruarq
+ * @date 28.02.2022 
+ *
+ * Copyright (C) 2022 ruarq
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include "Crc32cHash.hpp"
+
+#include <array>
+
+#include "Words.hpp"
+
+#if defined(__x86_64__)
+	#define LM_CRC32C_X86 1
+	#include <nmmintrin.h>
+#else
+	#define LM_CRC32C_X86 0
+#endif
+
+namespace Lm
+{
+
+namespace
+{
+
+/// Reflected Castagnoli polynomial
+constexpr std::uint32_t polynomial = 0x82f63b78;
+
+constexpr auto MakeTable() -> std::array<std::uint32_t, 256>
+{
+	std::array<std::uint32_t, 256> table = {};
+	for (std::uint32_t i = 0; i < 256; ++i)
+	{
+		auto crc = i;
+		for (int bit = 0; bit < 8; ++bit)
+		{
+			crc = (crc >> 1) ^ (crc & 1 ? polynomial : 0);
+		}
+		table[i] = crc;
+	}
+	return table;
+}
+
+constexpr auto table = MakeTable();
+
+/**
+ * @brief CRC32C of the 8 bytes of a word, same as the crc32 instruction
+ */
+inline auto Crc32cWordSoftware(std::uint32_t crc, std::uint64_t word) -> std::uint32_t
+{
+	for (int i = 0; i < 8; ++i, word >>= 8)
+	{
+		crc = table[(crc ^ word) & 0xff] ^ (crc >> 8);
+	}
+	return crc;
+}
+
+#if LM_CRC32C_X86
+
+__attribute__((target("sse4.2"))) auto Crc32cBlockHardware(const std::uint32_t crc,
+	const std::uint64_t low,
+	const std::uint64_t high) -> std::uint32_t
+{
+	return static_cast<std::uint32_t>(_mm_crc32_u64(_mm_crc32_u64(crc, low), high));
+}
+
+auto HasCrc32Instruction() -> bool
+{
+	__builtin_cpu_init();
+	return __builtin_cpu_supports("sse4.2");
+}
+
+const bool hardware = HasCrc32Instruction();
+
+#else
+
+constexpr bool hardware = false;
+
+#endif
+
+}
+
+Crc32cHash::Crc32cHash(const std::uint64_t seed)
+	: seed(seed)
+{
+}
+
+auto Crc32cHash::operator()(const std::string_view str) const -> std::uint64_t
+{
+	return HashWords(*this, str);
+}
+
+auto Crc32cHash::Crc32cBlock(const std::uint32_t crc,
+	const std::uint64_t low,
+	const std::uint64_t high) -> std::uint32_t
+{
+	// Both versions hash the same words, so they give the same results
+#if LM_CRC32C_X86
+	if (hardware)
+	{
+		return Crc32cBlockHardware(crc, low, high);
+	}
+#endif
+
+	return Crc32cWordSoftware(Crc32cWordSoftware(crc, low), high);
+}
+
+auto Crc32cHash::Hardware() -> bool
+{
+	return hardware;
+}
+
+}
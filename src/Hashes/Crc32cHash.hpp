@@ -0,0 +1,82 @@
+/**
+ * @author ruarq
+ * @date 28.02.2022 
+ *
+ * Copyright (C) 2022 ruarq
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+namespace Lm
+{
+
+/**
+ * @brief Hash policy using CRC32C, through the SSE4.2 crc32 instruction if the cpu has
+ * it and a lookup table if it doesn't.
+ *
+ * The 32 bit checksum is multiplied into 64 bits, so the top bits used for picking
+ * a shard depend on every input byte too.
+ */
+struct Crc32cHash final
+{
+	static constexpr auto name = "crc32c";
+
+	explicit Crc32cHash(const std::uint64_t seed = 0);
+
+	auto operator()(const std::string_view str) const -> std::uint64_t;
+
+	inline auto Begin() const -> std::uint64_t
+	{
+		return static_cast<std::uint32_t>(seed ^ (seed >> 32));
+	}
+
+	inline auto Update(const std::uint64_t state,
+		const std::uint64_t low,
+		const std::uint64_t high) const -> std::uint64_t
+	{
+		return Crc32cBlock(static_cast<std::uint32_t>(state), low, high);
+	}
+
+	inline auto Finish(const std::uint64_t state, const size_t size) const -> std::uint64_t
+	{
+		// Fold in the size, the last word is zero padded
+		return (state ^ (static_cast<std::uint64_t>(size) << 32)) * 0x9e3779b97f4a7c15;
+	}
+
+	/**
+	 * @brief CRC32C of the 16 bytes of a block
+	 */
+	static auto Crc32cBlock(const std::uint32_t crc,
+		const std::uint64_t low,
+		const std::uint64_t high) -> std::uint32_t;
+
+	/**
+	 * @brief Whether the crc32 instruction is used
+	 */
+	static auto Hardware() -> bool;
+
+	std::uint64_t seed;
+};
+
+}
@@ -25,15 +25,19 @@
 
 #include "MurmurHash.hpp"
 
-#include "MurmurHash2_64.inl"
+#include "Words.hpp"
 
 namespace Lm
 {
 
-auto MurmurHash::operator()(const std::string &str) const -> size_t
+MurmurHash::MurmurHash(const std::uint64_t seed)
+	: seed(seed)
 {
-	const static auto seed = std::time(nullptr);
-	return MurmurHash64A(str.data(), str.size(), seed);
+}
+
+auto MurmurHash::operator()(const std::string_view str) const -> std::uint64_t
+{
+	return HashWords(*this, str);
 }
 
 }
@@ -26,15 +26,60 @@
 #pragma once
 
 #include <cstdint>
-#include <ctime>
-#include <string>
+#include <string_view>
 
 namespace Lm
 {
 
+/**
+ * @brief Hash policy using a variant of MurmurHash64A by Austin Appleby.
+ *
+ * MurmurHash64A mixes the size into the initial state, which isn't known while the
+ * lexer still scans an identifier. This variant folds the size in before the final
+ * avalanche instead, and mixes the zero padded last block like every other block.
+ */
 struct MurmurHash final
 {
-	auto operator()(const std::string &str) const -> size_t;
+	static constexpr auto name = "murmur";
+
+	static constexpr std::uint64_t m = 0xc6a4a7935bd1e995;
+	static constexpr int r = 47;
+
+	explicit MurmurHash(const std::uint64_t seed = 0);
+
+	auto operator()(const std::string_view str) const -> std::uint64_t;
+
+	inline auto Begin() const -> std::uint64_t
+	{
+		return seed;
+	}
+
+	inline auto Update(const std::uint64_t state,
+		const std::uint64_t low,
+		const std::uint64_t high) const -> std::uint64_t
+	{
+		return Round(Round(state, low), high);
+	}
+
+	inline auto Finish(std::uint64_t state, const size_t size) const -> std::uint64_t
+	{
+		state ^= size * m;
+		state ^= state >> r;
+		state *= m;
+		state ^= state >> r;
+		return state;
+	}
+
+	std::uint64_t seed;
+
+private:
+	static inline auto Round(const std::uint64_t state, std::uint64_t word) -> std::uint64_t
+	{
+		word *= m;
+		word ^= word >> r;
+		word *= m;
+		return (state ^ word) * m;
+	}
 };
 
 }
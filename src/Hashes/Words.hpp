@@ -0,0 +1,115 @@
+/**
+ * @author ruarq
+ * @date 02.03.2022 
+ *
+ * Copyright (C) 2022 ruarq
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+namespace Lm
+{
+
+/**
+ * @brief Little endian word of 8 bytes
+ */
+inline auto ReadWord(const char *p) -> std::uint64_t
+{
+	std::uint64_t word;
+	std::memcpy(&word, p, sizeof(word));
+	return word;
+}
+
+/**
+ * @brief Word of the first size bytes (1 to 7) at p, zero padded. Doesn't read
+ * outside of the size bytes.
+ */
+inline auto ReadPartialWord(const char *p, const size_t size) -> std::uint64_t
+{
+	const auto Byte = [p](const size_t i) {
+		return static_cast<std::uint64_t>(static_cast<unsigned char>(p[i])) << (i * 8);
+	};
+
+	if (size >= 4)
+	{
+		// Two overlapping 4 byte loads, the overlapping bytes are the same in both
+		std::uint32_t low;
+		std::uint32_t high;
+		std::memcpy(&low, p, sizeof(low));
+		std::memcpy(&high, p + size - 4, sizeof(high));
+		return low | (static_cast<std::uint64_t>(high) << ((size - 4) * 8));
+	}
+
+	return Byte(0) | Byte(size >> 1) | Byte(size - 1);
+}
+
+/**
+ * @brief Word of the last size bytes (1 to 8) before end, zero padded. Reads the 8
+ * bytes before end.
+ */
+inline auto ReadWordBefore(const char *end, const size_t size) -> std::uint64_t
+{
+	return ReadWord(end - 8) >> ((64 - size * 8) & 63);
+}
+
+/**
+ * @brief Hash a string block by block with an incremental hash policy.
+ *
+ * The string is split into blocks of two 8 byte words, the last block zero padded.
+ * Every policy defines its hash this way, so code that already has the blocks at hand
+ * (like the lexer while it scans an identifier) gets the same hash as hashing the
+ * string later. Strings of up to 16 bytes are a single block, hashing them doesn't
+ * branch on their size beyond picking the loads.
+ */
+template<typename HashPolicy>
+inline auto HashWords(const HashPolicy &hasher, const std::string_view str) -> std::uint64_t
+{
+	const auto p = str.data();
+	const auto size = str.size();
+	auto state = hasher.Begin();
+
+	if (size >= 8)
+	{
+		size_t i = 0;
+		for (; size - i > 16; i += 16)
+		{
+			state = hasher.Update(state, ReadWord(p + i), ReadWord(p + i + 8));
+		}
+
+		// The last 1 to 16 bytes
+		const auto rest = size - i;
+		const auto low = rest > 8 ? ReadWord(p + i) : ReadWordBefore(p + size, rest);
+		const auto high = rest > 8 ? ReadWordBefore(p + size, rest - 8) : 0;
+		state = hasher.Update(state, low, high);
+	}
+	else if (size > 0)
+	{
+		state = hasher.Update(state, ReadPartialWord(p, size), 0);
+	}
+
+	return hasher.Finish(state, size);
+}
+
+}
@@ -1,6 +1,6 @@
 /**
  * @author ruarq
- * @date 21.02.2022 
+ * @date 28.02.2022 
  *
  * Copyright (C) 2022 ruarq
  * 
@@ -23,14 +23,21 @@
  * IN THE SOFTWARE.
  */
 
-#include "ReturnStmt.hpp"
+#include "WyHash.hpp"
 
-namespace Lm::Ast
+#include "Words.hpp"
+
+namespace Lm
+{
+
+WyHash::WyHash(const std::uint64_t seed)
+	: seed(seed ^ Mix(seed ^ secret[0], secret[1]))
 {
+}
 
-ReturnStmt::~ReturnStmt()
+auto WyHash::operator()(const std::string_view str) const -> std::uint64_t
 {
-	LM_DELETE(expr);
+	return HashWords(*this, str);
 }
 
 }
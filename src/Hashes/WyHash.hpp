@@ -0,0 +1,86 @@
+/**
+ * @author ruarq
+ * @date 28.02.2022 
+ *
+ * Copyright (C) 2022 ruarq
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+namespace Lm
+{
+
+/**
+ * @brief Hash policy modeled after wyhash (https://github.com/wangyi-fudan/wyhash).
+ *
+ * Every 16 byte block is mixed into the state with a 64x64->128 bit multiplication,
+ * the halves of the product are folded together. Identifier sized strings are a
+ * single block, they take two multiplications. See HashWords for how strings are
+ * split into blocks.
+ */
+struct WyHash final
+{
+	static constexpr auto name = "wyhash";
+
+	static constexpr std::uint64_t secret[] = {
+		0xa0761d6478bd642f,
+		0xe7037ed1a0b428db,
+		0x8ebc6af09c88c6e3,
+		0x589965cc75374cc3,
+	};
+
+	explicit WyHash(const std::uint64_t seed = 0);
+
+	auto operator()(const std::string_view str) const -> std::uint64_t;
+
+	/**
+	 * @brief Multiply to 128 bits and fold the halves
+	 */
+	static inline auto Mix(const std::uint64_t a, const std::uint64_t b) -> std::uint64_t
+	{
+		const auto r = static_cast<unsigned __int128>(a) * b;
+		return static_cast<std::uint64_t>(r) ^ static_cast<std::uint64_t>(r >> 64);
+	}
+
+	inline auto Begin() const -> std::uint64_t
+	{
+		return seed;
+	}
+
+	inline auto Update(const std::uint64_t state,
+		const std::uint64_t low,
+		const std::uint64_t high) const -> std::uint64_t
+	{
+		return Mix(low ^ secret[1], high ^ state);
+	}
+
+	inline auto Finish(const std::uint64_t state, const size_t size) const -> std::uint64_t
+	{
+		return Mix(state ^ secret[2] ^ size, seed ^ secret[3]);
+	}
+
+	std::uint64_t seed;
+};
+
+}
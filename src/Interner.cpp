@@ -0,0 +1,185 @@
+/**
+ * @author ruarq
+ * @date 24.02.2022 
+ *
+ * Copyright (C) 2022 ruarq
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include "Interner.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace Lm
+{
+
+template<typename HashPolicy>
+Interner<HashPolicy>::~Interner()
+{
+	for (auto &segment : segments)
+	{
+		delete[] segment.load(std::memory_order_relaxed);
+	}
+}
+
+template<typename HashPolicy>
+auto Interner<HashPolicy>::Intern(const std::string_view str) -> symbol_id_t
+{
+	return Intern(str, static_cast<std::uint32_t>(hasher(str)));
+}
+
+template<typename HashPolicy>
+auto Interner<HashPolicy>::Intern(const std::string_view str, const std::uint32_t hash)
+	-> symbol_id_t
+{
+	// Keep the load factor at or below 3/4
+	if ((count + 1) * 4 > slots.size() * 3)
+	{
+		Grow();
+	}
+
+	const auto mask = slots.size() - 1;
+
+	for (auto i = hash & mask;; i = (i + 1) & mask)
+	{
+		auto &slot = slots[i];
+		if (slot.id == notInterned)
+		{
+			slot.hash = hash;
+			slot.id = Add(str);
+			++count;
+			return slot.id;
+		}
+
+		if (slot.hash == hash && Get(slot.id) == str)
+		{
+			return slot.id;
+		}
+	}
+}
+
+template<typename HashPolicy>
+auto Interner<HashPolicy>::Find(const std::string_view str, const std::uint32_t hash) const
+	-> symbol_id_t
+{
+	if (slots.empty())
+	{
+		return notInterned;
+	}
+
+	const auto mask = slots.size() - 1;
+
+	for (auto i = hash & mask;; i = (i + 1) & mask)
+	{
+		const auto &slot = slots[i];
+		if (slot.id == notInterned || (slot.hash == hash && Get(slot.id) == str))
+		{
+			return slot.id;
+		}
+	}
+}
+
+template<typename HashPolicy>
+auto Interner<HashPolicy>::Size() const -> size_t
+{
+	return size;
+}
+
+template<typename HashPolicy>
+auto Interner<HashPolicy>::Stats() const -> TableStats
+{
+	TableStats stats;
+	stats.slots = slots.size();
+
+	const auto mask = slots.size() - 1;
+	for (size_t i = 0; i < slots.size(); ++i)
+	{
+		if (slots[i].id == notInterned)
+		{
+			continue;
+		}
+
+		const auto probe = ((i - slots[i].hash) & mask) + 1;
+		++stats.used;
+		stats.collisions += probe > 1;
+		stats.maxProbe = std::max(stats.maxProbe, probe);
+		stats.totalProbe += probe;
+	}
+
+	return stats;
+}
+
+template<typename HashPolicy>
+auto Interner<HashPolicy>::DropTable() -> void
+{
+	slots = std::vector<Slot>();
+	count = 0;
+}
+
+template<typename HashPolicy>
+auto Interner<HashPolicy>::Add(const std::string_view str) -> symbol_id_t
+{
+	const auto id = static_cast<symbol_id_t>(size);
+	const auto [segment, index] = Locate(id);
+
+	auto strings = segments[segment].load(std::memory_order_relaxed);
+	if (!strings)
+	{
+		strings = new std::string_view[firstSegmentSize << segment];
+		segments[segment].store(strings, std::memory_order_release);
+	}
+
+	auto data = static_cast<char *>(arena.Allocate(str.size(), 1));
+	std::memcpy(data, str.data(), str.size());
+	strings[index] = std::string_view(data, str.size());
+
+	++size;
+	return id;
+}
+
+template<typename HashPolicy>
+auto Interner<HashPolicy>::Grow() -> void
+{
+	auto old = std::move(slots);
+	slots.assign(old.empty() ? initialCapacity : old.size() * 2, Slot{ 0, notInterned });
+
+	const auto mask = slots.size() - 1;
+	for (const auto &slot : old)
+	{
+		if (slot.id == notInterned)
+		{
+			continue;
+		}
+
+		auto i = slot.hash & mask;
+		while (slots[i].id != notInterned)
+		{
+			i = (i + 1) & mask;
+		}
+		slots[i] = slot;
+	}
+}
+
+template class Interner<MurmurHash>;
+template class Interner<WyHash>;
+template class Interner<Crc32cHash>;
+
+}
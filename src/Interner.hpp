@@ -0,0 +1,213 @@
+/**
+ * @author ruarq
+ * @date 24.02.2022 
+ *
+ * Copyright (C) 2022 ruarq
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include "Arena.hpp"
+#include "Hashes/Crc32cHash.hpp"
+#include "Hashes/MurmurHash.hpp"
+#include "Hashes/WyHash.hpp"
+
+namespace Lm
+{
+
+using symbol_id_t = std::uint32_t;
+
+/// Returned by lookups of strings that aren't interned
+constexpr symbol_id_t notInterned = ~symbol_id_t(0);
+
+/// Hash policy of the symbol table, see Interner
+using DefaultHash = WyHash;
+
+/**
+ * @brief Occupancy of interner hash tables
+ */
+struct TableStats final
+{
+	size_t slots = 0;
+	size_t used = 0;
+	size_t collisions = 0;	  ///< Entries that aren't in the slot their hash points to
+	size_t maxProbe = 0;	  ///< Most slots a lookup of an interned string looks at
+	size_t totalProbe = 0;	  ///< Sum of the probe lengths of all entries
+
+	inline auto LoadFactor() const -> double
+	{
+		return slots ? (double)used / (double)slots : 0.0;
+	}
+
+	inline auto AverageProbe() const -> double
+	{
+		return used ? (double)totalProbe / (double)used : 0.0;
+	}
+
+	inline auto operator+=(const TableStats &other) -> TableStats &
+	{
+		slots += other.slots;
+		used += other.used;
+		collisions += other.collisions;
+		maxProbe = maxProbe > other.maxProbe ? maxProbe : other.maxProbe;
+		totalProbe += other.totalProbe;
+		return *this;
+	}
+};
+
+/**
+ * @brief Maps strings to dense ids and back.
+ *
+ * The strings are copied into an arena and never move, so the table can key on
+ * string_views into it. The table uses open addressing with linear probing and
+ * caches the hash of every entry, a lookup hashes once and walks the probe
+ * sequence once, inserting on the first empty slot if the string isn't there.
+ *
+ * Interning isn't synchronized, see SharedInterner for that. Get() is safe to call
+ * while another thread interns, for any id that was handed out before: the id to
+ * string mapping is kept in segments that never move.
+ *
+ * HashPolicy is a function object mapping a std::string_view to a std::uint64_t
+ * (MurmurHash, WyHash or Crc32cHash), which also hashes incrementally through
+ * Begin(), Update() and Finish() (see HashWords). The table uses the low 32 bits.
+ */
+template<typename HashPolicy = DefaultHash>
+class Interner final
+{
+public:
+	explicit Interner(const HashPolicy &hasher = HashPolicy())
+		: hasher(hasher)
+	{
+	}
+
+	Interner(const Interner &) = delete;
+	~Interner();
+
+	auto operator=(const Interner &) -> Interner & = delete;
+
+public:
+	/**
+	 * @brief Get the id of a string, adds the string if it's new
+	 */
+	auto Intern(const std::string_view str) -> symbol_id_t;
+
+	/**
+	 * @brief Same as Intern(str), with the hash of str already computed
+	 */
+	auto Intern(const std::string_view str, const std::uint32_t hash) -> symbol_id_t;
+
+	/**
+	 * @brief Get the id of a string without adding it
+	 * @return The id or notInterned
+	 */
+	auto Find(const std::string_view str, const std::uint32_t hash) const -> symbol_id_t;
+
+	/**
+	 * @brief Get the string of an id
+	 */
+	inline auto Get(const symbol_id_t id) const -> std::string_view
+	{
+		const auto [segment, index] = Locate(id);
+		return segments[segment].load(std::memory_order_acquire)[index];
+	}
+
+	/**
+	 * @brief Number of strings
+	 */
+	auto Size() const -> size_t;
+
+	/**
+	 * @brief Measure the hash table
+	 */
+	auto Stats() const -> TableStats;
+
+	/**
+	 * @brief Free the lookup table. Existing ids and strings stay valid, interning
+	 * afterwards starts with an empty table.
+	 */
+	auto DropTable() -> void;
+
+	/**
+	 * @brief The hash function used by Intern(str)
+	 */
+	inline auto Hash(const std::string_view str) const -> std::uint64_t
+	{
+		return hasher(str);
+	}
+
+private:
+	struct Slot final
+	{
+		std::uint32_t hash;
+		symbol_id_t id;
+	};
+
+	struct Location final
+	{
+		size_t segment;
+		size_t index;
+	};
+
+	static constexpr size_t initialCapacity = 1024;
+
+	/// Segment n holds firstSegmentSize << n strings
+	static constexpr size_t firstSegmentBits = 6;
+	static constexpr size_t firstSegmentSize = size_t(1) << firstSegmentBits;
+	static constexpr size_t segmentCount = 32 - firstSegmentBits + 1;
+
+private:
+	static inline auto Locate(const symbol_id_t id) -> Location
+	{
+		const auto n = static_cast<std::uint64_t>(id) + firstSegmentSize;
+		const auto segment = static_cast<size_t>(63 - __builtin_clzll(n)) - firstSegmentBits;
+		return { segment, static_cast<size_t>(n - (firstSegmentSize << segment)) };
+	}
+
+	/**
+	 * @brief Copy a string into the arena and give it the next id
+	 */
+	auto Add(const std::string_view str) -> symbol_id_t;
+
+	/**
+	 * @brief Double the capacity and reinsert using the cached hashes
+	 */
+	auto Grow() -> void;
+
+private:
+	std::vector<Slot> slots;
+	size_t count = 0; ///< Used slots
+	size_t size = 0;  ///< Number of strings
+	std::array<std::atomic<std::string_view *>, segmentCount> segments{};
+	Arena arena;
+	HashPolicy hasher;
+};
+
+extern template class Interner<MurmurHash>;
+extern template class Interner<WyHash>;
+extern template class Interner<Crc32cHash>;
+
+}
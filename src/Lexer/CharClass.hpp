@@ -0,0 +1,84 @@
+/**
+ * @author ruarq
+ * @date 20.02.2022 
+ *
+ * Copyright (C) 2022 ruarq
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+/**
+ * @brief Character classification through a 256 entry lookup table, shared by
+ * everything that needs to know what kind of character it looks at.
+ */
+namespace Lm::CharClass
+{
+
+using class_t = std::uint8_t;
+
+constexpr class_t whitespace = 1 << 0;	  ///< ' ', '\t', '\n', '\r', '\f'
+constexpr class_t digit = 1 << 1;		  ///< 0-9
+constexpr class_t upper = 1 << 2;		  ///< A-Z
+constexpr class_t lower = 1 << 3;		  ///< a-z
+constexpr class_t underscore = 1 << 4;	  ///< _
+
+constexpr class_t identStart = upper | lower | underscore;
+constexpr class_t ident = identStart | digit;
+
+constexpr auto MakeTable() -> std::array<class_t, 256>
+{
+	std::array<class_t, 256> table = {};
+
+	table[' '] = table['\t'] = table['\n'] = table['\r'] = table['\f'] = whitespace;
+	table['_'] = underscore;
+
+	for (auto c = '0'; c <= '9'; ++c)
+	{
+		table[c] = digit;
+	}
+
+	for (auto c = 'A'; c <= 'Z'; ++c)
+	{
+		table[c] = upper;
+	}
+
+	for (auto c = 'a'; c <= 'z'; ++c)
+	{
+		table[c] = lower;
+	}
+
+	return table;
+}
+
+constexpr auto table = MakeTable();
+
+/**
+ * @return True if c belongs to any of the classes in "classes"
+ */
+constexpr auto Is(const char c, const class_t classes) -> bool
+{
+	return table[static_cast<unsigned char>(c)] & classes;
+}
+
+}
@@ -25,108 +25,136 @@
 
 #include "Lexer.hpp"
 
-#define COLUMN_START 1
-#define LINE_START 1
+#include "CharClass.hpp"
+#include "Scan.hpp"
 
 namespace Lm
 {
 
-Lexer::Lexer(const File &file, const Diagnostics &diagnostics)
+template<typename HashPolicy>
+Lexer<HashPolicy>::Lexer(const File &file, const Diagnostics &diagnostics, const HashPolicy &hasher)
 	: start(file.Buf())
 	, curr(start)
 	, end(file.Buf() + file.Size())
-	, pos({ .line = LINE_START, .column = COLUMN_START, .offset = 0 })
-	, line(LINE_START)
-	, column(COLUMN_START)
+	, pos({ .offset = 0 })
 	, diagnostics(diagnostics)
+	, hasher(hasher)
 {
 }
 
-auto Lexer::NextToken() -> Lm::Token
+template<typename HashPolicy>
+auto Lexer<HashPolicy>::NextToken() -> Lm::Token
 {
 #if LM_LEXER_BUFFER_ENABLE
-	if (bufToken >= buffer.size())
+	if (bufToken >= bufSize)
 	{
+		// Once the lexer reached the sentinel, every further refill yields another eof token
 		bufToken = 0;
-		for (auto token = buffer.begin(); token != buffer.end() && !Eof(); ++token)
-		{
-			*token = LexToken();
-			token->pos = pos;
-		}
+		bufSize = Fill(buffer.data(), buffer.size());
 	}
 
 	return buffer[bufToken++];
 #else
-	auto token = LexToken();
-	token.pos = pos;
+	Token token;
+	Emit(token);
 	return token;
 #endif
 }
 
-auto Lexer::Eof() const -> bool
+template<typename HashPolicy>
+auto Lexer<HashPolicy>::Fill(Token *tokens, const size_t capacity) -> size_t
 {
-	return curr >= end;
+	size_t size = 0;
+	do
+	{
+		Emit(tokens[size++]);
+	} while (size < capacity && tokens[size - 1].type != Token::Type::Eof);
+
+	return size;
 }
 
-auto Lexer::LexToken() -> Lm::Token
+template<typename HashPolicy>
+auto Lexer<HashPolicy>::Tokenize() -> TokenStream
 {
-L_LEX_TOKEN:
+	TokenStream stream(start);
 
-	if (Eof())
+	// Just a guess, most tokens (including the whitespace before them) are a few characters long
+	stream.Reserve((end - start) / 4 + 1);
+
+	Token token;
+	do
 	{
-		return Token::Type::Eof;
-	}
+		Emit(token);
+		stream.Push(token);
+	} while (token.type != Token::Type::Eof);
+
+	return stream;
+}
+
+template<typename HashPolicy>
+auto Lexer<HashPolicy>::Eof() const -> bool
+{
+	return curr >= end;
+}
+
+template<typename HashPolicy>
+auto Lexer<HashPolicy>::Emit(Token &token) -> void
+{
+	// The token is written field by field where it's stored. Returning it by value
+	// makes gcc assemble it on the stack and reload it as a whole, which stalls on
+	// every token.
+	token.type = LexToken();
+	token.pos = pos;
+	token.size = (curr - start) - pos.offset;
+	token.hash = token.type == Token::Type::Ident ? hash : 0;
+}
+
+template<typename HashPolicy>
+auto Lexer<HashPolicy>::Text(const Token &token) const -> std::string_view
+{
+	return std::string_view(start + token.pos.offset, token.size);
+}
+
+template<typename HashPolicy>
+auto Lexer<HashPolicy>::LexToken() -> Token::Type
+{
+	// The file buffer is terminated by (at least) LM_FILE_PADDING NUL bytes. None of the
+	// scanning loops below accept '\0', so they all stop at the sentinel without
+	// comparing against the end of the buffer.
+L_LEX_TOKEN:
 
-	pos.line = line;
-	pos.column = column;
 	pos.offset = curr - start;
 
-	++column;
 	switch (*curr++)
 	{
+		case '\0':
+			if (curr > end)
+			{
+				// Stay on the sentinel, so every following call returns eof again
+				--curr;
+				return Token::Type::Eof;
+			}
+			break;
+
 		// Skip whitespace
 		case '\n':
-			++line;
-			column = COLUMN_START;
-			[[fallthrough]];
 		case ' ':
 		case '\t':
 		case '\r':
 		case '\f':
-		{
-			auto prev = curr;
-			while (curr < end && (*curr == ' ' || *curr == '\n' || *curr == '\t'))
-			{
-				if (*curr == '\n')
-				{
-					column = COLUMN_START;
-					prev = curr;
-					++line;
-				}
-
-				++curr;
-			}
-			column += curr - prev;
+			curr = Scan::SkipWhitespace(curr);
 			goto L_LEX_TOKEN;
-		}
 
-		// Skip comments
+		// Skip comments, the newline itself is handled as whitespace
 		case '#':
-			while (*curr != '\n')
-			{
-				++curr;
-			}
-			++curr;	   // \n
-			column = COLUMN_START;
-			++line;
+			curr = Scan::SkipComment(curr);
 			goto L_LEX_TOKEN;
 
 		case '0' ... '9':
 		{
-			const auto tokStart = curr - 1;
 			auto type = Token::Type::Int32Literal;
 
-			while (curr < end && *curr >= '0' && *curr <= '9')
+			while (CharClass::Is(*curr, CharClass::digit))
 			{
 				++curr;
 			}
@@ -135,14 +163,13 @@ L_LEX_TOKEN:
 			{
 				type = Token::Type::Float64Literal;
 				++curr;
-				while (*curr >= '0' && *curr <= '9')
+				while (CharClass::Is(*curr, CharClass::digit))
 				{
 					++curr;
 				}
 			}
 
-			column += curr - tokStart - 1;
-			return Token(type, std::string(tokStart, curr));
+			return type;
 		}
 
 		case 'A' ... 'Z':
@@ -151,25 +178,13 @@ L_LEX_TOKEN:
 		{
 			const auto tokStart = curr - 1;
 
-			while (
-				curr < end && ((*curr >= 'A' && *curr <= 'Z') || (*curr >= 'a' && *curr <= 'z') ||
-								  (*curr >= '0' && *curr <= '9') || (*curr == '_')))
-			{
-				++curr;
-			}
+			curr = Scan::ScanIdentifier(tokStart, hasher, hash);
 
-			column += curr - tokStart - 1;
-
-			std::string symbol(tokStart, curr);
-
-			const auto type = GetKeywordType(symbol);
-			if (type == Token::Type::Ident)
+			const std::string_view text(tokStart, curr - tokStart);
+			const auto type = GetKeywordType(text);
+			if (type == Token::Type::Ident && !ValidateIdentifier(text))
 			{
-				if (!ValidateIdentifier(symbol))
-				{
-					goto L_LEX_TOKEN;
-				}
-				return Token(type, std::move(symbol));
+				goto L_LEX_TOKEN;
 			}
 
 			return type;
@@ -177,30 +192,40 @@ L_LEX_TOKEN:
 
 		case '"':
 		{
-			const auto tokStart = curr - 1;
-			while (curr < end && *curr != '"' && *curr != '\n')
+			while (*curr != '"' && *curr != '\n' && *curr != '\0')
 			{
 				++curr;
 			}
 
-			if (*curr++ != '"')
+			if (*curr == '"')
+			{
+				++curr;
+			}
+			else
 			{
 				diagnostics.Error(pos, Locale::Get("LEXER_ERROR_UNTERMINATED_STRING"));
 			}
 
-			column += curr - tokStart - 1;
-
-			return Token(Token::Type::StringLiteral, std::string(tokStart, curr - 1));
+			return Token::Type::StringLiteral;
 		}
 
 		case '\'':
 		{
-			std::string symbol = { *curr++ };
-			if (*curr != '\'')
+			while (*curr != '\'' && *curr != '\n' && *curr != '\0')
+			{
+				++curr;
+			}
+
+			if (*curr == '\'')
+			{
+				++curr;
+			}
+			else
 			{
 				diagnostics.Error(pos, Locale::Get("LEXER_ERROR_UNTERMINATED_CHAR"));
 			}
-			return Token(Token::Type::CharLiteral, std::move(symbol));
+
+			return Token::Type::CharLiteral;
 		}
 
 		case '(': return Token::Type::LParen;
@@ -250,16 +275,11 @@ L_LEX_TOKEN:
 			return Token::Type::Colon;
 
 		case '+':
-			if (*curr == '+')
+			if (*curr == '=')
 			{
 				Next();
 				return Token::Type::PlusEqual;
 			}
-			else if (*curr == '=')
-			{
-				Next();
-				return Token::Type::Plus;
-			}
 			return Token::Type::Plus;
 
 		case '*':
@@ -325,7 +345,7 @@ L_LEX_TOKEN:
 			}
 			else if (*curr == '=')
 			{
-				++curr;
+				Next();
 				return Token::Type::GreaterEqual;
 			}
 			return Token::Type::Greater;
@@ -375,19 +395,22 @@ L_LEX_TOKEN:
 		default: break;
 	}
 
-	diagnostics.Error(pos, fmt::format(Locale::Get("LEXER_ERROR_UNKNOWN_TOKEN"), *curr));
+	diagnostics.Error(pos, fmt::format(Locale::Get("LEXER_ERROR_UNKNOWN_TOKEN"), curr[-1]));
 	goto L_LEX_TOKEN;
 }
 
-auto Lexer::Next() -> void
+template<typename HashPolicy>
+auto Lexer<HashPolicy>::Next() -> void
 {
 	++curr;
-	++column;
 }
 
-auto Lexer::ValidateIdentifier(const std::string &identifier) -> bool
+template<typename HashPolicy>
+auto Lexer<HashPolicy>::ValidateIdentifier(const std::string_view identifier) -> bool
 {
-	if (identifier.size() >= 2 && identifier[0] == '_' && identifier[1] == '_')
+	// Identifiers starting with two underscores are reserved for the compiler
+	if (identifier.size() >= 2 && CharClass::Is(identifier[0], CharClass::underscore) &&
+		CharClass::Is(identifier[1], CharClass::underscore))
 	{
 		diagnostics.Error(pos, fmt::format(Locale::Get("LEXER_ERROR_INVALID_IDENT"), identifier));
 		return false;
@@ -396,4 +419,8 @@ auto Lexer::ValidateIdentifier(const std::string &identifier) -> bool
 	return true;
 }
 
+template class Lexer<MurmurHash>;
+template class Lexer<WyHash>;
+template class Lexer<Crc32cHash>;
+
 }
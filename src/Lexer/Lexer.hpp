@@ -28,23 +28,38 @@
 #include <array>
 #include <cstdint>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include <fmt/format.h>
 
 #include "../Diagnostics.hpp"
 #include "../File.hpp"
+#include "../Interner.hpp"
 #include "../Logger.hpp"
 #include "../Macros.hpp"
 #include "Token.hpp"
+#include "TokenStream.hpp"
 
 namespace Lm
 {
 
+/**
+ * @brief Splits the content of a file into tokens. Relies on the NUL padding
+ * Lm::File guarantees after the content.
+ *
+ * Identifiers are hashed with the hash of the symbol table while they're scanned,
+ * the parser interns them with the hash from the token. HashPolicy has to be the
+ * policy of that symbol table, see Interner.
+ */
+template<typename HashPolicy = DefaultHash>
 class Lexer final
 {
 public:
-	Lexer(const File &file, const Diagnostics &diagnostics);
+	/**
+	 * @param hasher The hash of the symbol table the identifiers go into
+	 */
+	Lexer(const File &file, const Diagnostics &diagnostics, const HashPolicy &hasher);
 
 public:
 	/**
@@ -52,16 +67,37 @@ public:
 	 */
 	auto NextToken() -> Token;
 
+	/**
+	 * @brief Lex up to capacity tokens into tokens, stops after the eof token
+	 * @return The number of tokens stored
+	 */
+	auto Fill(Token *tokens, const size_t capacity) -> size_t;
+
+	/**
+	 * @brief Lex the whole file at once
+	 */
+	auto Tokenize() -> TokenStream;
+
 	/**
 	 * @return True if eof
 	 */
 	auto Eof() const -> bool;
 
+	/**
+	 * @brief View the text of a token in the source
+	 */
+	auto Text(const Token &token) const -> std::string_view;
+
 private:
 	/**
-	 * @brief Lex one token
+	 * @brief Lex one token into token, with its position, size and hash
 	 */
-	auto LexToken() -> Token;
+	inline auto Emit(Token &token) -> void;
+
+	/**
+	 * @brief Lex one token, sets hash for identifiers
+	 */
+	auto LexToken() -> Token::Type;
 
 	/**
 	 * @brief Next char
@@ -71,7 +107,7 @@ private:
 	/**
 	 * @brief validate identifiers
 	 */
-	inline auto ValidateIdentifier(const std::string &identifier) -> bool;
+	inline auto ValidateIdentifier(const std::string_view identifier) -> bool;
 
 private:
 	const char *start;
@@ -79,15 +115,20 @@ private:
 	const char *end;
 
 	SourcePos pos;
-	line_t line;
-	column_t column;
+	std::uint32_t hash = 0; ///< Hash of the identifier LexToken() scanned last
 
 	const Diagnostics &diagnostics;
+	const HashPolicy &hasher;
 
 #if LM_LEXER_BUFFER_ENABLE
-	size_t bufToken = LM_LEXER_BUFFER_SIZE;
+	size_t bufToken = 0;
+	size_t bufSize = 0;
 	std::array<Token, LM_LEXER_BUFFER_SIZE> buffer;
 #endif
 };
 
+extern template class Lexer<MurmurHash>;
+extern template class Lexer<WyHash>;
+extern template class Lexer<Crc32cHash>;
+
 }
@@ -0,0 +1,269 @@
+/**
+ * @author ruarq
+ * @date 19.02.2022 
+ *
+ * Copyright (C) 2022 ruarq
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include "Scan.hpp"
+
+#include "../Macros.hpp"
+
+#if LM_LEXER_SIMD_ENABLE && (defined(__x86_64__) || defined(__i386__))
+	#define LM_SCAN_X86 1
+	#include <immintrin.h>
+#else
+	#define LM_SCAN_X86 0
+#endif
+
+namespace Lm::Scan
+{
+
+namespace
+{
+
+using SkipWhitespaceFn = const char *(*)(const char *);
+using SkipCommentFn = const char *(*)(const char *);
+using FindNewlinesFn = void (*)(const char *, size_t, std::vector<offset_t> &);
+
+struct Kernels final
+{
+	SkipWhitespaceFn skipWhitespace;
+	SkipCommentFn skipComment;
+	FindNewlinesFn findNewlines;
+	const char *isa;
+};
+
+auto SkipWhitespaceScalar(const char *curr) -> const char *
+{
+	while (CharClass::Is(*curr, CharClass::whitespace))
+	{
+		++curr;
+	}
+	return curr;
+}
+
+auto SkipCommentScalar(const char *curr) -> const char *
+{
+	while (*curr != '\n' && *curr != '\0')
+	{
+		++curr;
+	}
+	return curr;
+}
+
+auto FindNewlinesScalar(const char *buf, const size_t size, std::vector<offset_t> &starts)
+	-> void
+{
+	for (size_t i = 0; i < size; ++i)
+	{
+		if (buf[i] == '\n')
+		{
+			starts.push_back(i + 1);
+		}
+	}
+}
+
+#if LM_SCAN_X86
+
+/**
+ * @brief Push the offset after every set bit of a newline mask, dropping bits past size
+ */
+inline auto PushNewlines(unsigned mask,
+	const size_t base,
+	const size_t size,
+	std::vector<offset_t> &starts) -> void
+{
+	if (size - base < 32)
+	{
+		mask &= (1u << (size - base)) - 1;
+	}
+
+	while (mask)
+	{
+		starts.push_back(base + __builtin_ctz(mask) + 1);
+		mask &= mask - 1;
+	}
+}
+
+auto SkipWhitespaceSse2(const char *curr) -> const char *
+{
+	const auto space = _mm_set1_epi8(' ');
+	const auto tab = _mm_set1_epi8('\t');
+	const auto newline = _mm_set1_epi8('\n');
+	const auto cr = _mm_set1_epi8('\r');
+	const auto ff = _mm_set1_epi8('\f');
+
+	while (true)
+	{
+		const auto block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(curr));
+		const auto ws = _mm_or_si128(
+			_mm_or_si128(_mm_cmpeq_epi8(block, space), _mm_cmpeq_epi8(block, newline)),
+			_mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(block, tab), _mm_cmpeq_epi8(block, cr)),
+				_mm_cmpeq_epi8(block, ff)));
+
+		const unsigned mask = _mm_movemask_epi8(ws);
+		if (mask != 0xffff)
+		{
+			return curr + __builtin_ctz(~mask);
+		}
+
+		curr += 16;
+	}
+}
+
+auto SkipCommentSse2(const char *curr) -> const char *
+{
+	const auto newline = _mm_set1_epi8('\n');
+	const auto zero = _mm_setzero_si128();
+
+	while (true)
+	{
+		const auto block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(curr));
+		const unsigned mask = _mm_movemask_epi8(
+			_mm_or_si128(_mm_cmpeq_epi8(block, newline), _mm_cmpeq_epi8(block, zero)));
+
+		if (mask)
+		{
+			return curr + __builtin_ctz(mask);
+		}
+
+		curr += 16;
+	}
+}
+
+auto FindNewlinesSse2(const char *buf, const size_t size, std::vector<offset_t> &starts) -> void
+{
+	const auto newline = _mm_set1_epi8('\n');
+
+	// The padding after the buffer makes the last partial block safe to load
+	for (size_t i = 0; i < size; i += 16)
+	{
+		const auto block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(buf + i));
+		PushNewlines(_mm_movemask_epi8(_mm_cmpeq_epi8(block, newline)), i, size, starts);
+	}
+}
+
+__attribute__((target("avx2"))) auto SkipWhitespaceAvx2(const char *curr) -> const char *
+{
+	const auto space = _mm256_set1_epi8(' ');
+	const auto tab = _mm256_set1_epi8('\t');
+	const auto newline = _mm256_set1_epi8('\n');
+	const auto cr = _mm256_set1_epi8('\r');
+	const auto ff = _mm256_set1_epi8('\f');
+
+	while (true)
+	{
+		const auto block = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(curr));
+		const auto ws = _mm256_or_si256(
+			_mm256_or_si256(_mm256_cmpeq_epi8(block, space), _mm256_cmpeq_epi8(block, newline)),
+			_mm256_or_si256(
+				_mm256_or_si256(_mm256_cmpeq_epi8(block, tab), _mm256_cmpeq_epi8(block, cr)),
+				_mm256_cmpeq_epi8(block, ff)));
+
+		const unsigned mask = _mm256_movemask_epi8(ws);
+		if (mask != 0xffffffff)
+		{
+			return curr + __builtin_ctz(~mask);
+		}
+
+		curr += 32;
+	}
+}
+
+__attribute__((target("avx2"))) auto SkipCommentAvx2(const char *curr) -> const char *
+{
+	const auto newline = _mm256_set1_epi8('\n');
+	const auto zero = _mm256_setzero_si256();
+
+	while (true)
+	{
+		const auto block = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(curr));
+		const unsigned mask = _mm256_movemask_epi8(
+			_mm256_or_si256(_mm256_cmpeq_epi8(block, newline), _mm256_cmpeq_epi8(block, zero)));
+
+		if (mask)
+		{
+			return curr + __builtin_ctz(mask);
+		}
+
+		curr += 32;
+	}
+}
+
+__attribute__((target("avx2"))) auto FindNewlinesAvx2(const char *buf,
+	const size_t size,
+	std::vector<offset_t> &starts) -> void
+{
+	const auto newline = _mm256_set1_epi8('\n');
+
+	for (size_t i = 0; i < size; i += 32)
+	{
+		const auto block = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(buf + i));
+		PushNewlines(_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, newline)), i, size, starts);
+	}
+}
+
+#endif
+
+auto SelectKernels() -> Kernels
+{
+#if LM_SCAN_X86
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx2"))
+	{
+		return { SkipWhitespaceAvx2, SkipCommentAvx2, FindNewlinesAvx2, "avx2" };
+	}
+
+	if (__builtin_cpu_supports("sse2"))
+	{
+		return { SkipWhitespaceSse2, SkipCommentSse2, FindNewlinesSse2, "sse2" };
+	}
+#endif
+
+	return { SkipWhitespaceScalar, SkipCommentScalar, FindNewlinesScalar, "scalar" };
+}
+
+const Kernels kernels = SelectKernels();
+
+}
+
+auto SkipWhitespace(const char *curr) -> const char *
+{
+	return kernels.skipWhitespace(curr);
+}
+
+auto SkipComment(const char *curr) -> const char *
+{
+	return kernels.skipComment(curr);
+}
+
+auto FindNewlines(const char *buf, const size_t size, std::vector<offset_t> &starts) -> void
+{
+	kernels.findNewlines(buf, size, starts);
+}
+
+auto Isa() -> const char *
+{
+	return kernels.isa;
+}
+
+}
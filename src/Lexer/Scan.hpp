@@ -0,0 +1,169 @@
+/**
+ * @author ruarq
+ * @date 19.02.2022 
+ *
+ * Copyright (C) 2022 ruarq
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "../Hashes/Words.hpp"
+#include "../Macros.hpp"
+#include "CharClass.hpp"
+#include "Token.hpp"
+
+#if LM_LEXER_SIMD_ENABLE && defined(__SSE2__)
+	#define LM_SCAN_SSE2 1
+	#include <emmintrin.h>
+#else
+	#define LM_SCAN_SSE2 0
+#endif
+
+/**
+ * @brief Vectorized scanning kernels used by the lexer. The best kernel for the
+ * cpu is chosen once at startup, there is always a scalar fallback.
+ *
+ * All kernels expect a buffer terminated by a NUL sentinel followed by enough
+ * padding for a full vector load (see LM_FILE_PADDING).
+ */
+namespace Lm::Scan
+{
+
+/**
+ * @brief Skip ' ', '\t', '\n', '\r' and '\f'
+ * @return Pointer to the first character that isn't whitespace
+ */
+auto SkipWhitespace(const char *curr) -> const char *;
+
+/**
+ * @brief Skip until the next '\n' or the sentinel
+ * @return Pointer to the '\n' or '\0'
+ */
+auto SkipComment(const char *curr) -> const char *;
+
+/**
+ * @brief Append the offset following every '\n' in buf[0, size) to starts
+ */
+auto FindNewlines(const char *buf, const size_t size, std::vector<offset_t> &starts) -> void;
+
+/**
+ * @brief Skip [A-Za-z0-9_] and hash the skipped characters on the way.
+ *
+ * The identifier is read 16 bytes at a time, every block is classified in one go and
+ * handed to the hash as it is (see HashWords), the block with the end of the
+ * identifier with the bytes after it masked off. That's the same hash as
+ * hasher(identifier), without reading the identifier a second time. Identifiers of
+ * up to 16 characters take a single pass through the loop.
+ *
+ * This doesn't go through the runtime dispatch. SSE2 is part of every x86-64 cpu and
+ * gets inlined into the lexer.
+ *
+ * @param curr The first character of the identifier
+ * @param hash Receives the low 32 bits of the hash, see SharedInterner
+ * @return Pointer to the first character that can't be part of an identifier
+ */
+template<typename HashPolicy>
+inline auto ScanIdentifier(const char *curr, const HashPolicy &hasher, std::uint32_t &hash)
+	-> const char *
+{
+	const auto identStart = curr;
+	auto state = hasher.Begin();
+
+#if LM_SCAN_SSE2
+	const auto InRange = [](const __m128i x, const char lo, const char hi) {
+		return _mm_cmpeq_epi8(_mm_min_epu8(_mm_max_epu8(x, _mm_set1_epi8(lo)), _mm_set1_epi8(hi)),
+			x);
+	};
+
+	const auto index = _mm_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+
+	while (true)
+	{
+		auto block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(curr));
+
+		// Setting bit 5 maps A-Z onto a-z and nothing else onto a-z
+		const auto letter = InRange(_mm_or_si128(block, _mm_set1_epi8(0x20)), 'a', 'z');
+		const auto ident = _mm_or_si128(_mm_or_si128(letter, InRange(block, '0', '9')),
+			_mm_cmpeq_epi8(block, _mm_set1_epi8('_')));
+
+		const unsigned count = __builtin_ctz(~static_cast<unsigned>(_mm_movemask_epi8(ident)));
+		if (count == 0)
+		{
+			// The identifier ended with the previous block
+			break;
+		}
+
+		// Zero the bytes past the identifier
+		block = _mm_and_si128(block, _mm_cmpgt_epi8(_mm_set1_epi8(count), index));
+		state = hasher.Update(state,
+			_mm_cvtsi128_si64(block),
+			_mm_cvtsi128_si64(_mm_unpackhi_epi64(block, block)));
+
+		curr += count;
+		if (count < 16)
+		{
+			break;
+		}
+	}
+#else
+	while (true)
+	{
+		unsigned count = 0;
+		while (count < 16 && CharClass::Is(curr[count], CharClass::ident))
+		{
+			++count;
+		}
+
+		if (count == 0)
+		{
+			break;
+		}
+
+		const auto Bytes = [](const std::uint64_t word, const unsigned n) {
+			return n >= 8 ? word : word & ((std::uint64_t(1) << (n * 8)) - 1);
+		};
+
+		state = hasher.Update(state,
+			Bytes(ReadWord(curr), count),
+			Bytes(ReadWord(curr + 8), count > 8 ? count - 8 : 0));
+
+		curr += count;
+		if (count < 16)
+		{
+			break;
+		}
+	}
+#endif
+
+	hash = static_cast<std::uint32_t>(hasher.Finish(state, curr - identStart));
+	return curr;
+}
+
+/**
+ * @brief Name of the instruction set the kernels use
+ */
+auto Isa() -> const char *;
+
+}
@@ -25,311 +25,160 @@
 
 #include "Token.hpp"
 
+#include <cstddef>
+
+#include "CharClass.hpp"
+
 namespace Lm
 {
 
-Token::Token()
-	: type(Token::Type::Eof)
+namespace
 {
-}
 
-Token::Token(const Type type)
-	: type(type)
+/**
+ * @brief Entry of the keyword table
+ */
+struct Keyword final
 {
-}
+	std::string_view str;
+	Token::Type type;
+};
+
+// clang-format off
+constexpr Keyword keywords[] = {
+	{ "fn",       Token::Type::Fn },
+	{ "i8",       Token::Type::Int8 },
+	{ "if",       Token::Type::If },
+	{ "u8",       Token::Type::UInt8 },
+	{ "f32",      Token::Type::Float32 },
+	{ "f64",      Token::Type::Float64 },
+	{ "for",      Token::Type::For },
+	{ "i16",      Token::Type::Int16 },
+	{ "i32",      Token::Type::Int32 },
+	{ "i64",      Token::Type::Int64 },
+	{ "let",      Token::Type::Let },
+	{ "mut",      Token::Type::Mut },
+	{ "ret",      Token::Type::Ret },
+	{ "u16",      Token::Type::UInt16 },
+	{ "u32",      Token::Type::UInt32 },
+	{ "u64",      Token::Type::UInt64 },
+	{ "bool",     Token::Type::Bool },
+	{ "char",     Token::Type::Char },
+	{ "elif",     Token::Type::Elif },
+	{ "else",     Token::Type::Else },
+	{ "long",     Token::Type::Long },
+	{ "loop",     Token::Type::Loop },
+	{ "true",     Token::Type::True },
+	{ "break",    Token::Type::Break },
+	{ "false",    Token::Type::False },
+	{ "local",    Token::Type::Local },
+	{ "match",    Token::Type::Match },
+	{ "ulong",    Token::Type::ULong },
+	{ "import",   Token::Type::Import },
+	{ "module",   Token::Type::Module },
+	{ "struct",   Token::Type::Struct },
+	{ "continue", Token::Type::Continue },
+};
+// clang-format on
+
+constexpr size_t maxKeywordSize = 8;
+constexpr size_t keywordSlotBits = 7;
+constexpr size_t keywordSlots = 1 << keywordSlotBits;
 
-Token::Token(const Type type, const Symbol symbol)
-	: type(type)
-	, symbol(symbol)
+/**
+ * @brief Pack a string of up to 8 characters into a word, unused bytes are 0.
+ * Two words are equal exactly if the strings are equal (identifiers never contain '\0').
+ */
+constexpr auto Word(const char *str, const size_t size) -> std::uint64_t
 {
+	std::uint64_t word = 0;
+	for (size_t i = 0; i < size; ++i)
+	{
+		word |= static_cast<std::uint64_t>(static_cast<unsigned char>(str[i])) << (i * 8);
+	}
+	return word;
 }
 
-auto GetKeywordType(const std::string &str) -> Token::Type
+constexpr auto CheckKeywordSizes() -> bool
 {
-	switch (str.size())
+	for (const auto &keyword : keywords)
 	{
-		case 2:
-			switch (str[0])
-			{
-				case 'f': return str[1] == 'n' ? Token::Type::Fn : Token::Type::Ident;
-				case 'i':
-					switch (str[1])
-					{
-						case '8': return Token::Type::Int8;
-						case 'f': return Token::Type::If;
-						default: return Token::Type::Ident;
-					}
-
-				case 'u': return str[1] == '8' ? Token::Type::UInt8 : Token::Type::Ident;
-
-				default: return Token::Type::Ident;
-			}
-
-		case 3:
-			switch (str[0])
-			{
-				case 'f':
-					switch (str[1])
-					{
-						case '3':
-							if (str[2] == '2')
-							{
-								return Token::Type::Float32;
-							}
-							return Token::Type::Ident;
-
-						case '6':
-							if (str[2] == '4')
-							{
-								return Token::Type::Float64;
-							}
-							return Token::Type::Ident;
-
-						case 'o':
-							if (str[2] == 'r')
-							{
-								return Token::Type::For;
-							}
-							return Token::Type::Ident;
-
-						default: return Token::Type::Ident;
-					}
-
-				case 'i':
-					switch (str[1])
-					{
-						case '1':
-							if (str[2] == '6')
-							{
-								return Token::Type::Int16;
-							}
-							return Token::Type::Ident;
-
-						case '3':
-							if (str[2] == '2')
-							{
-								return Token::Type::Int32;
-							}
-							return Token::Type::Ident;
-
-						case '6':
-							if (str[2] == '4')
-							{
-								return Token::Type::Int64;
-							}
-							return Token::Type::Ident;
-
-						default: return Token::Type::Ident;
-					}
-
-				case 'l':
-					if (str[1] == 'e' && str[2] == 't')
-					{
-						return Token::Type::Let;
-					}
-					return Token::Type::Ident;
-
-				case 'm':
-					if (str[1] == 'u' && str[2] == 't')
-					{
-						return Token::Type::Mut;
-					}
-					return Token::Type::Ident;
-
-				case 'r':
-					if (str[1] == 'e' && str[2] == 't')
-					{
-						return Token::Type::Ret;
-					}
-					return Token::Type::Ident;
-
-				case 'u':
-					switch (str[1])
-					{
-						case '1':
-							if (str[2] == '6')
-							{
-								return Token::Type::UInt16;
-							}
-							return Token::Type::Ident;
-
-						case '3':
-							if (str[2] == '2')
-							{
-								return Token::Type::UInt32;
-							}
-							return Token::Type::Ident;
+		if (keyword.str.size() > maxKeywordSize)
+		{
+			return false;
+		}
+	}
+	return true;
+}
 
-						case '6':
-							if (str[2] == '4')
-							{
-								return Token::Type::UInt64;
-							}
-							return Token::Type::Ident;
+static_assert(CheckKeywordSizes(), "keywords may not be longer than 8 characters");
 
-						default: return Token::Type::Ident;
-					}
+constexpr auto Slot(const std::uint64_t word, const std::uint64_t seed) -> size_t
+{
+	return (word * seed) >> (64 - keywordSlotBits);
+}
 
-				default: return Token::Type::Ident;
-			}
+/**
+ * @brief Perfect hash table over the keywords, generated at compile time
+ */
+struct KeywordTable final
+{
+	std::uint64_t seed = 0;
+	std::uint64_t words[keywordSlots] = {};
+	Token::Type types[keywordSlots] = {};
+};
 
-		case 4:
-			switch (str[0])
+constexpr auto MakeKeywordTable() -> KeywordTable
+{
+	// Try multiplicative hashes until one of them maps every keyword to its own slot
+	for (std::uint64_t attempt = 1;; ++attempt)
+	{
+		KeywordTable table;
+		table.seed = (attempt * 0x9e3779b97f4a7c15) | 1;
+
+		for (auto &type : table.types)
+		{
+			type = Token::Type::Ident;
+		}
+
+		bool collision = false;
+		for (const auto &keyword : keywords)
+		{
+			const auto word = Word(keyword.str.data(), keyword.str.size());
+			const auto slot = Slot(word, table.seed);
+			if (table.words[slot] != 0)
 			{
-				case 'b':
-					if (str[1] == 'o' && str[2] == 'o' && str[3] == 'l')
-					{
-						return Token::Type::Bool;
-					}
-					return Token::Type::Ident;
-
-				case 'c':
-					if (str[1] == 'h' && str[2] == 'a' && str[3] == 'r')
-					{
-						return Token::Type::Char;
-					}
-					return Token::Type::Ident;
-
-				case 'e':
-					if (str[1] == 'l')
-					{
-						switch (str[2])
-						{
-							case 'i':
-								if (str[3] == 'f')
-								{
-									return Token::Type::Elif;
-								}
-								return Token::Type::Ident;
-
-							case 's':
-								if (str[3] == 'e')
-								{
-									return Token::Type::Else;
-								}
-								return Token::Type::Ident;
-
-							default: return Token::Type::Ident;
-						}
-					}
-					return Token::Type::Ident;
-
-				case 'l':
-					switch (str[1])
-					{
-						case 'o':
-							switch (str[2])
-							{
-								case 'o':
-									if (str[3] == 'p')
-									{
-										return Token::Type::Loop;
-									}
-									return Token::Type::Ident;
-
-								case 'n':
-									if (str[3] == 'g')
-									{
-										return Token::Type::Long;
-									}
-									return Token::Type::Ident;
-
-								default: return Token::Type::Ident;
-							}
-
-						default: return Token::Type::Ident;
-					}
-
-				case 't':
-					if (str[1] == 'r' && str[2] == 'u' && str[3] == 'e')
-					{
-						return Token::Type::True;
-					}
-					return Token::Type::Ident;
-
-				default: return Token::Type::Ident;
+				collision = true;
+				break;
 			}
 
-		case 5:
-			switch (str[0])
-			{
-				case 'b':
-					if (str[1] == 'r' && str[2] == 'e' && str[3] == 'a' && str[4] == 'k')
-					{
-						return Token::Type::Break;
-					}
-					return Token::Type::Ident;
-
-				case 'f':
-					if (str[1] == 'a' && str[2] == 'l' && str[3] == 's' && str[4] == 'e')
-					{
-						return Token::Type::False;
-					}
-					return Token::Type::Ident;
+			table.words[slot] = word;
+			table.types[slot] = keyword.type;
+		}
 
-				case 'l':
-					if (str[1] == 'o' && str[2] == 'c' && str[3] == 'a' && str[4] == 'l')
-					{
-						return Token::Type::Local;
-					}
-					return Token::Type::Ident;
-
-				case 'm':
-					if (str[1] == 'a' && str[2] == 't' && str[3] == 'c' && str[4] == 'h')
-					{
-						return Token::Type::Match;
-					}
-					return Token::Type::Ident;
-
-				case 'u':
-					if (str[1] == 'l' && str[2] == 'o' && str[3] == 'n' && str[4] == 'g')
-					{
-						return Token::Type::ULong;
-					}
-					return Token::Type::Ident;
-
-				default: return Token::Type::Ident;
-			}
-
-		case 6:
-			switch (str[1])
-			{
-				case 'i':
-					if (str[1] == 'm' && str[2] == 'p' && str[3] == 'o' && str[4] == 'r' &&
-						str[5] == 't')
-					{
-						return Token::Type::Import;
-					}
-					return Token::Type::Ident;
+		if (!collision)
+		{
+			return table;
+		}
+	}
+}
 
-				case 'm':
-					if (str[1] == 'o' && str[2] == 'd' && str[3] == 'u' && str[4] == 'l' &&
-						str[5] == 'e')
-					{
-						return Token::Type::Module;
-					}
-					return Token::Type::Ident;
+constexpr auto keywordTable = MakeKeywordTable();
 
-				case 's':
-					if (str[1] == 't' && str[2] == 'r' && str[3] == 'u' && str[4] == 'c' &&
-						str[5] == 't')
-					{
-						return Token::Type::Struct;
-					}
-					return Token::Type::Ident;
+}
 
-				default: return Token::Type::Ident;
-			}
+auto GetKeywordType(const std::string_view str) -> Token::Type
+{
+	// Every keyword starts with a lowercase letter
+	if (str.empty() || str.size() > maxKeywordSize || !CharClass::Is(str[0], CharClass::lower))
+	{
+		return Token::Type::Ident;
+	}
 
-		case 8:
-			if (str == "continue")
-			{
-				return Token::Type::Continue;
-			}
-			return Token::Type::Ident;
+	const auto word = Word(str.data(), str.size());
+	const auto slot = Slot(word, keywordTable.seed);
 
-		default: return Token::Type::Ident;
-	}
+	return keywordTable.words[slot] == word ? keywordTable.types[slot] : Token::Type::Ident;
 }
 
 }
@@ -26,25 +26,38 @@
 #pragma once
 
 #include <cstdint>
+#include <string_view>
 
-#include "../Symbol.hpp"
 
 namespace Lm
 {
 
-using line_t = unsigned long;
-using column_t = unsigned long;
-using offset_t = unsigned long;
+using line_t = std::uint32_t;
+using column_t = std::uint32_t;
+using offset_t = std::uint32_t;
 
+/**
+ * @brief Position in a file. Only the offset gets stored, line and column are
+ * derived on demand through the line index of the file (see LineIndex).
+ */
 struct SourcePos final
+{
+	offset_t offset;
+};
+
+/**
+ * @brief Line and column of a SourcePos, both start at 1
+ */
+struct LineColumn final
 {
 	line_t line;
 	column_t column;
-	offset_t offset;
 };
 
 /**
- * @brief stores all information about a lexical token
+ * @brief stores all information about a lexical token. The text of the token isn't
+ * copied, it can be viewed in the source through pos.offset and size
+ * (see Lexer::Text).
  */
 class Token final
 {
@@ -146,16 +159,41 @@ public:
 	};
 
 public:
-	Token();
-	Token(const Type type);
-	Token(const Type type, const Symbol symbol);
+	// Inline, so tokens can be put together in registers
+	constexpr Token()
+		: Token(Type::Eof)
+	{
+	}
+
+	constexpr Token(const Type type)
+		: pos({ .offset = 0 })
+		, size(0)
+		, hash(0)
+		, type(type)
+	{
+	}
 
 public:
-	Type type;		  ///< The type of the token
-	Symbol symbol;	  ///< The tokens symbol
-	SourcePos pos;	  ///< The source of the token (just positional data)
+	SourcePos pos;			///< The source of the token (just positional data)
+	std::uint32_t size;		///< Number of characters of the token in the source
+	std::uint32_t hash;		///< Symbol table hash of identifiers (see Lexer), 0 otherwise
+	Type type;				///< The type of the token
+
+private:
+	/// Explicit tail padding, so copies of a token move all 16 bytes. Without it gcc
+	/// copies the 13 used bytes with overlapping loads, which can't be forwarded from
+	/// the stores before them. Not an array, gcc keeps arrays in memory while it puts
+	/// a token together.
+	std::uint8_t pad0 = 0;
+	std::uint8_t pad1 = 0;
+	std::uint8_t pad2 = 0;
 };
 
-auto GetKeywordType(const std::string &str) -> Token::Type;
+static_assert(sizeof(Token) == 16, "tokens are kept in large buffers, keep them compact");
+
+/**
+ * @brief Get the keyword type of a string, Token::Type::Ident if it isn't a keyword
+ */
+auto GetKeywordType(const std::string_view str) -> Token::Type;
 
 }
@@ -0,0 +1,165 @@
+/**
+ * @author ruarq
+ * @date 05.03.2022 
+ *
+ * Copyright (C) 2022 ruarq
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include "TokenPipe.hpp"
+
+namespace Lm
+{
+
+TokenPipe::TokenPipe(Lexer<> &lexer)
+	: lexer(lexer)
+	, batches(LM_TOKEN_PIPE_BATCHES)
+	, thread(&TokenPipe::Produce, this)
+{
+}
+
+TokenPipe::~TokenPipe()
+{
+	{
+		std::lock_guard lock(mutex);
+		stop = true;
+	}
+	drained.notify_one();
+	Finish();
+}
+
+auto TokenPipe::Text(const Token &token) const -> std::string_view
+{
+	return lexer.Text(token);
+}
+
+auto TokenPipe::Finish() -> void
+{
+	if (thread.joinable())
+	{
+		thread.join();
+	}
+}
+
+auto TokenPipe::ProducerStalls() const -> Stalls
+{
+	return producerStalls;
+}
+
+auto TokenPipe::ConsumerStalls() const -> Stalls
+{
+	return consumerStalls;
+}
+
+auto TokenPipe::Batches() const -> size_t
+{
+	return tail.load(std::memory_order_acquire);
+}
+
+auto TokenPipe::Produce() -> void
+{
+	size_t next = 0;
+	Token::Type last;
+	do
+	{
+		// The slot of batch next is free once the parser is done with the batch a full
+		// ring before it
+		if (next - head.load(std::memory_order_acquire) == batches.size())
+		{
+			const auto start = std::chrono::steady_clock::now();
+			{
+				std::unique_lock lock(mutex);
+				drained.wait(lock, [this, next] {
+					return stop || next - head.load(std::memory_order_acquire) < batches.size();
+				});
+				if (stop)
+				{
+					return;
+				}
+			}
+
+			++producerStalls.count;
+			producerStalls.time += std::chrono::steady_clock::now() - start;
+		}
+
+		auto &batch = batches[next % batches.size()];
+		Logger::Redirect(&batch.diagnostics);
+		batch.size = lexer.Fill(batch.tokens.data(), batch.tokens.size());
+		Logger::Redirect(nullptr);
+		last = batch.tokens[batch.size - 1].type;
+
+		// Publishes the tokens of the batch along with it. Taking the mutex makes sure
+		// the parser either sees the new tail or already waits for the signal.
+		tail.store(++next, std::memory_order_release);
+		{
+			std::lock_guard lock(mutex);
+		}
+		filled.notify_one();
+	} while (last != Token::Type::Eof);
+}
+
+auto TokenPipe::Refill() -> Token
+{
+	auto next = head.load(std::memory_order_relaxed);
+	if (current)
+	{
+		// The lexer stopped after the batch with the eof token
+		if (current[size - 1].type == Token::Type::Eof)
+		{
+			return current[size - 1];
+		}
+
+		head.store(++next, std::memory_order_release);
+		{
+			std::lock_guard lock(mutex);
+		}
+		drained.notify_one();
+	}
+
+	if (tail.load(std::memory_order_acquire) == next)
+	{
+		const auto start = std::chrono::steady_clock::now();
+		{
+			std::unique_lock lock(mutex);
+			filled.wait(lock, [this, next] {
+				return tail.load(std::memory_order_acquire) != next;
+			});
+		}
+
+		++consumerStalls.count;
+		consumerStalls.time += std::chrono::steady_clock::now() - start;
+	}
+
+	auto &batch = batches[next % batches.size()];
+
+	// The lexer without the pipe reports while it refills, right before this batch
+	const auto diagnostics = batch.diagnostics.Take();
+	if (!diagnostics.empty())
+	{
+		Logger::Print(diagnostics);
+	}
+
+	current = batch.tokens.data();
+	size = batch.size;
+	index = 1;
+	return current[0];
+}
+
+}
@@ -0,0 +1,168 @@
+/**
+ * @author ruarq
+ * @date 05.03.2022 
+ *
+ * Copyright (C) 2022 ruarq
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <string_view>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "../Logger.hpp"
+#include "../Macros.hpp"
+#include "Lexer.hpp"
+#include "Token.hpp"
+
+namespace Lm
+{
+
+/**
+ * @brief Runs a lexer on its own thread, so lexing overlaps with parsing. The lexer
+ * fills batches of tokens in a lock-free ring with a single producer and a single
+ * consumer, the parser drains them (see Parser).
+ *
+ * Nothing but the pipe may use the lexer while the pipe exists. A side that has to
+ * wait for the other one blocks. The errors of the lexer are held back with their
+ * batch and printed when the parser gets to it, which is where the lexer would have
+ * reported them without the pipe.
+ */
+class TokenPipe final
+{
+public:
+	/**
+	 * @brief How often and how long one side of the pipe waited for the other
+	 */
+	struct Stalls final
+	{
+		size_t count = 0;
+		std::chrono::nanoseconds time{ 0 };
+	};
+
+public:
+	/**
+	 * @brief Start lexing on a new thread
+	 */
+	explicit TokenPipe(Lexer<> &lexer);
+	TokenPipe(const TokenPipe &) = delete;
+	~TokenPipe();
+
+	auto operator=(const TokenPipe &) -> TokenPipe & = delete;
+
+public:
+	/**
+	 * @brief Get the next token, waits for the lexer if the ring is empty. Every call
+	 * after the eof token returns eof again.
+	 */
+	inline auto NextToken() -> Token
+	{
+		if (index < size)
+		{
+			return current[index++];
+		}
+
+		return Refill();
+	}
+
+	/**
+	 * @brief View the text of a token in the source
+	 */
+	auto Text(const Token &token) const -> std::string_view;
+
+	/**
+	 * @brief Wait for the lexer thread to exit, it does once the eof token is in the
+	 * ring. The stalls of the lexer are valid after this.
+	 */
+	auto Finish() -> void;
+
+	/**
+	 * @brief Waits of the lexer on a full ring
+	 */
+	auto ProducerStalls() const -> Stalls;
+
+	/**
+	 * @brief Waits of the parser on an empty ring
+	 */
+	auto ConsumerStalls() const -> Stalls;
+
+	/**
+	 * @brief Number of batches the lexer put into the ring so far
+	 */
+	auto Batches() const -> size_t;
+
+private:
+	struct Batch final
+	{
+		std::array<Token, LM_TOKEN_PIPE_BATCH_SIZE> tokens;
+		size_t size = 0;
+		LogBuffer diagnostics;	  ///< What the lexer reported while filling it
+	};
+
+private:
+	/**
+	 * @brief Body of the lexer thread
+	 */
+	auto Produce() -> void;
+
+	/**
+	 * @brief Hand the current batch back to the lexer and take the next one
+	 */
+	auto Refill() -> Token;
+
+private:
+	Lexer<> &lexer;
+	std::vector<Batch> batches;
+
+	/// Batches the parser is done with, only the parser writes it
+	alignas(64) std::atomic<size_t> head = 0;
+
+	/// Batches the lexer filled, only the lexer writes it
+	alignas(64) std::atomic<size_t> tail = 0;
+
+	/// Tells the lexer to give up waiting for room, set when the pipe is destroyed
+	bool stop = false;
+
+	/// Only for blocking on a full or empty ring, the ring itself doesn't need it
+	std::mutex mutex;
+	std::condition_variable filled;		///< Signaled when the lexer filled a batch
+	std::condition_variable drained;	///< Signaled when the parser is done with a batch
+
+	/// Batch the parser reads from, null before the first one
+	alignas(64) const Token *current = nullptr;
+	size_t index = 0;
+	size_t size = 0;
+	Stalls consumerStalls;
+
+	/// Only touched by the lexer thread until it exited
+	alignas(64) Stalls producerStalls;
+
+	std::thread thread;
+};
+
+}
@@ -0,0 +1,76 @@
+/**
+ * @author ruarq
+ * @date 22.02.2022 
+ *
+ * Copyright (C) 2022 ruarq
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include "TokenStream.hpp"
+
+namespace Lm
+{
+
+TokenStream::TokenStream(const char *source)
+	: source(source)
+{
+}
+
+auto TokenStream::Push(const Token &token) -> void
+{
+	types.push_back(token.type);
+	offsets.push_back(token.pos.offset);
+	sizes.push_back(token.size);
+	hashes.push_back(token.hash);
+}
+
+auto TokenStream::Reserve(const size_t tokens) -> void
+{
+	types.reserve(tokens);
+	offsets.reserve(tokens);
+	sizes.reserve(tokens);
+	hashes.reserve(tokens);
+}
+
+auto TokenStream::Size() const -> size_t
+{
+	return types.size();
+}
+
+auto TokenStream::operator[](size_t index) const -> Token
+{
+	if (index >= types.size())
+	{
+		index = types.size() - 1;
+	}
+
+	Token token(types[index]);
+	token.size = sizes[index];
+	token.hash = hashes[index];
+	token.pos = { .offset = offsets[index] };
+	return token;
+}
+
+auto TokenStream::Text(const Token &token) const -> std::string_view
+{
+	return std::string_view(source + token.pos.offset, token.size);
+}
+
+}
@@ -0,0 +1,87 @@
+/**
+ * @author ruarq
+ * @date 22.02.2022 
+ *
+ * Copyright (C) 2022 ruarq
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include "Token.hpp"
+
+namespace Lm
+{
+
+/**
+ * @brief All tokens of a file in structure-of-arrays layout. Scanning only the
+ * token types touches one byte per token, and any token can be looked at in O(1).
+ *
+ * The last token is always Token::Type::Eof.
+ */
+class TokenStream final
+{
+public:
+	/**
+	 * @param source The buffer the tokens reference
+	 */
+	TokenStream(const char *source);
+
+public:
+	/**
+	 * @brief Append a token
+	 */
+	auto Push(const Token &token) -> void;
+
+	/**
+	 * @brief Reserve memory for a number of tokens
+	 */
+	auto Reserve(const size_t tokens) -> void;
+
+	/**
+	 * @brief Number of tokens, including the eof token
+	 */
+	auto Size() const -> size_t;
+
+	/**
+	 * @brief Get a token, indices past the end yield the eof token
+	 */
+	auto operator[](const size_t index) const -> Token;
+
+	/**
+	 * @brief View the text of a token in the source
+	 */
+	auto Text(const Token &token) const -> std::string_view;
+
+public:
+	std::vector<Token::Type> types;
+	std::vector<offset_t> offsets;
+	std::vector<std::uint32_t> sizes;
+	std::vector<std::uint32_t> hashes;
+
+private:
+	const char *source;
+};
+
+}
@@ -0,0 +1,75 @@
+/**
+ * @author ruarq
+ * @date 23.02.2022 
+ *
+ * Copyright (C) 2022 ruarq
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include "LineIndex.hpp"
+
+#include <algorithm>
+
+#include "Lexer/Scan.hpp"
+
+namespace Lm
+{
+
+LineIndex::LineIndex(const char *buf, const size_t size)
+	: buf(buf)
+	, size(size)
+{
+}
+
+auto LineIndex::Resolve(const SourcePos pos) const -> LineColumn
+{
+	Build();
+
+	// The first line start after the position, the line before it contains the position
+	const auto next = std::upper_bound(starts.begin(), starts.end(), pos.offset);
+	const auto line = static_cast<line_t>(next - starts.begin());
+	const auto column = static_cast<column_t>(pos.offset - *(next - 1) + 1);
+	return { .line = line, .column = column };
+}
+
+auto LineIndex::Line(const line_t line) const -> std::string_view
+{
+	Build();
+
+	const size_t start = starts[line - 1];
+	const size_t end = line < starts.size() ? starts[line] - 1 : size;
+	return std::string_view(buf + start, end - start);
+}
+
+auto LineIndex::Lines() const -> size_t
+{
+	Build();
+	return starts.size();
+}
+
+auto LineIndex::Build() const -> void
+{
+	std::call_once(built, [this] {
+		starts.push_back(0);
+		Scan::FindNewlines(buf, size, starts);
+	});
+}
+
+}
@@ -0,0 +1,83 @@
+/**
+ * @author ruarq
+ * @date 23.02.2022 
+ *
+ * Copyright (C) 2022 ruarq
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <mutex>
+#include <string_view>
+#include <vector>
+
+#include "Lexer/Token.hpp"
+
+namespace Lm
+{
+
+/**
+ * @brief Offsets of the line starts of a file. Used to derive line and column of
+ * a SourcePos, which only stores the offset.
+ *
+ * The index is only needed once a diagnostic has to be rendered, so it's built on
+ * the first lookup. Lookups are safe from multiple threads, the first one builds
+ * the index while the others wait for it.
+ */
+class LineIndex final
+{
+public:
+	/**
+	 * @brief Prepare the index of a buffer, the buffer has to outlive the index
+	 */
+	LineIndex(const char *buf, const size_t size);
+
+public:
+	/**
+	 * @brief Get line and column of a position
+	 */
+	auto Resolve(const SourcePos pos) const -> LineColumn;
+
+	/**
+	 * @brief Get the text of a line without the '\n'
+	 */
+	auto Line(const line_t line) const -> std::string_view;
+
+	/**
+	 * @brief Number of lines
+	 */
+	auto Lines() const -> size_t;
+
+private:
+	/**
+	 * @brief Build the index if it doesn't exist yet
+	 */
+	auto Build() const -> void;
+
+private:
+	const char *buf;
+	size_t size;
+	mutable std::vector<offset_t> starts;
+	mutable std::once_flag built;
+};
+
+}
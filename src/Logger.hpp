@@ -25,7 +25,9 @@
 
 #pragma once
 
+#include <mutex>
 #include <string>
+#include <utility>
 
 #include <fmt/color.h>
 #include <fmt/format.h>
@@ -41,6 +43,36 @@
 namespace Lm
 {
 
+/**
+ * @brief Collects the output of one file while the file gets compiled alongside
+ * others, so it can be printed in a fixed order later (see Logger::Redirect)
+ */
+class LogBuffer final
+{
+public:
+	/**
+	 * @brief Append to the buffer. Safe to call from multiple threads.
+	 */
+	auto Append(const std::string &text) -> void
+	{
+		std::lock_guard lock(mutex);
+		buffer += text;
+	}
+
+	/**
+	 * @brief Take the text out of the buffer
+	 */
+	auto Take() -> std::string
+	{
+		std::lock_guard lock(mutex);
+		return std::move(buffer);
+	}
+
+private:
+	std::mutex mutex;
+	std::string buffer;
+};
+
 class Logger final
 {
 public:
@@ -55,7 +87,16 @@ public:
 	template<typename... Args>
 	static auto Debug(const std::string &fmt, Args &&...args) -> void
 	{
-		fmt::print("{} {}\n",
+		Print(DebugText(fmt, args...));
+	}
+
+	/**
+	 * @brief Format a debug message the way Debug() prints it
+	 */
+	template<typename... Args>
+	static auto DebugText(const std::string &fmt, Args &&...args) -> std::string
+	{
+		return fmt::format("{} {}\n",
 			fmt::format(fmt::fg(debugColor), "[DEBUG]"),
 			fmt::format(fmt, args...));
 	}
@@ -66,7 +107,9 @@ public:
 	template<typename... Args>
 	static auto Info(const std::string &fmt, Args &&...args) -> void
 	{
-		fmt::print("{} {}\n", fmt::format(fmt::fg(infoColor), "[INFO]"), fmt::format(fmt, args...));
+		Print(fmt::format("{} {}\n",
+			fmt::format(fmt::fg(infoColor), "[INFO]"),
+			fmt::format(fmt, args...)));
 	}
 
 	/**
@@ -75,10 +118,45 @@ public:
 	template<typename... Args>
 	static auto Error(const std::string &fmt, Args &&...args) -> void
 	{
-		fmt::print("{} {}\n",
+		Print(fmt::format("{} {}\n",
 			fmt::format(fmt::fg(errorColor), "{}:", Locale::Get("ERROR")),
-			fmt::format(fmt, args...));
+			fmt::format(fmt, args...)));
+	}
+
+	/**
+	 * @brief Print text, or append it to the buffer of the calling thread
+	 */
+	static auto Print(const std::string &text) -> void
+	{
+		if (redirect)
+		{
+			redirect->Append(text);
+		}
+		else
+		{
+			fmt::print("{}", text);
+		}
 	}
+
+	/**
+	 * @brief Send everything the calling thread logs into buffer from now on, null to
+	 * print it again
+	 */
+	static auto Redirect(LogBuffer *buffer) -> void
+	{
+		redirect = buffer;
+	}
+
+	/**
+	 * @brief The buffer the calling thread logs into, null if it prints
+	 */
+	static auto Redirected() -> LogBuffer *
+	{
+		return redirect;
+	}
+
+private:
+	static inline thread_local LogBuffer *redirect = nullptr;
 };
 
 }
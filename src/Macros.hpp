@@ -31,9 +31,20 @@
 	#define LM_IGNORE_IN_RELEASE(x)
 #endif
 
+/// Number of NUL bytes guaranteed to follow the content of every Lm::File
+#define LM_FILE_PADDING 64
+
 #define LM_LEXER_BUFFER_ENABLE 1
+
+/// Use the SSE2/AVX2 scanning kernels on x86, 0 forces the scalar ones
+#define LM_LEXER_SIMD_ENABLE 1
 #define LM_LEXER_BUFFER_SIZE 1024
 
+/// Tokens per batch and number of batches in the ring of Lm::TokenPipe. Batches as big
+/// as the buffer of the lexer keep the lexer errors where they'd be without the pipe.
+#define LM_TOKEN_PIPE_BATCH_SIZE LM_LEXER_BUFFER_SIZE
+#define LM_TOKEN_PIPE_BATCHES 16
+
 #define LM_DELETE(ptr) \
 	if (ptr) \
 	{ \
@@ -1,6 +1,6 @@
 /**
  * @author ruarq
- * @date 18.02.2022 
+ * @date 05.03.2022 
  *
  * Copyright (C) 2022 ruarq
  * 
@@ -23,17 +23,30 @@
  * IN THE SOFTWARE.
  */
 
-#include "TranslationUnit.hpp"
+#pragma once
+
+#include "../../Symbol.hpp"
+#include "Expression.hpp"
 
 namespace Lm::Ast
 {
 
-TranslationUnit::~TranslationUnit()
+/**
+ * @brief Conversion of an expression to a builtin type, written expr $ type
+ */
+class CastExpr final : public Expression
 {
-	for (const auto stmt : statements)
+public:
+	static constexpr auto nodeKind = Kind::CastExpr;
+
+	constexpr CastExpr()
+		: Expression(nodeKind)
 	{
-		LM_DELETE(stmt);
 	}
-}
+
+public:
+	Expression *expr = nullptr;
+	Symbol type;
+};
 
 }
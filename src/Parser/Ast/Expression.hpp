@@ -33,7 +33,7 @@ namespace Lm::Ast
 class Expression : public Node
 {
 public:
-	virtual ~Expression() = default;
+	using Node::Node;
 };
 
 }
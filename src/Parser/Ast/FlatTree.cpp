@@ -0,0 +1,196 @@
+/**
+ * @author ruarq
+ * @date 04.03.2022 
+ *
+ * Copyright (C) 2022 ruarq
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include "FlatTree.hpp"
+
+#include "BinaryExpr.hpp"
+#include "CastExpr.hpp"
+#include "FunctionDecl.hpp"
+#include "Identifier.hpp"
+#include "Int32Expr.hpp"
+#include "ReturnStmt.hpp"
+#include "StmtBlock.hpp"
+#include "UnaryExpr.hpp"
+
+namespace Lm::Ast
+{
+
+auto FlatTree::FromTree(const TranslationUnit &unit) -> FlatTree
+{
+	FlatTree tree;
+
+	// Every node and child array of the pointer tree took one arena allocation, close
+	// enough to the number of nodes
+	const auto guess = unit.arena.Stats().allocations;
+	tree.kinds.reserve(guess);
+	tree.positions.reserve(guess);
+	tree.payloads.reserve(guess);
+	tree.children.reserve(guess);
+
+	tree.Convert(&unit);
+	return tree;
+}
+
+auto FlatTree::Bytes() const -> size_t
+{
+	return kinds.size() * sizeof(Kind) + positions.size() * sizeof(SourcePos)
+		+ payloads.size() * sizeof(std::uint32_t) + children.size() * sizeof(node_index_t)
+		+ ranges.size() * sizeof(Range) + functions.size() * sizeof(Function)
+		+ operations.size() * sizeof(Operation);
+}
+
+auto FlatTree::Add(const Kind kind, const SourcePos pos, const std::uint32_t payload)
+	-> node_index_t
+{
+	kinds.push_back(kind);
+	positions.push_back(pos);
+	payloads.push_back(payload);
+	return static_cast<node_index_t>(kinds.size() - 1);
+}
+
+auto FlatTree::Convert(const Node *root) -> void
+{
+	// Children are pushed in reverse, so nodes get their index in pre-order
+	std::vector<Pending> stack;
+	stack.push_back({ root, { Slot::Field::None, 0 } });
+
+	while (!stack.empty())
+	{
+		const auto [node, slot] = stack.back();
+		stack.pop_back();
+
+		if (!node)
+		{
+			Link(slot, noNode);
+			continue;
+		}
+
+		auto index = noNode;
+		switch (node->kind)
+		{
+			case Kind::TranslationUnit:
+			{
+				const auto unit = static_cast<const TranslationUnit *>(node);
+				index = Add(node->kind, node->pos, 0);
+				payloads[index] = Claim(unit->statements, stack);
+				break;
+			}
+
+			case Kind::FunctionDecl:
+			{
+				const auto fn = static_cast<const FunctionDecl *>(node);
+				const auto entry = static_cast<std::uint32_t>(functions.size());
+				index = Add(node->kind, node->pos, entry);
+				functions.push_back({ fn->ident.symbol, fn->ident.pos, fn->type, noNode });
+				stack.push_back({ fn->statements, { Slot::Field::Body, entry } });
+				break;
+			}
+
+			case Kind::StmtBlock:
+				index = Add(node->kind, node->pos, 0);
+				payloads[index] = Claim(static_cast<const StmtBlock *>(node)->statements, stack);
+				break;
+
+			case Kind::ReturnStmt:
+				index = Add(node->kind, node->pos, noNode);
+				stack.push_back({ static_cast<const ReturnStmt *>(node)->expr,
+					{ Slot::Field::Payload, index } });
+				break;
+
+			case Kind::Int32Expr:
+				index = Add(node->kind, node->pos, static_cast<const Int32Expr *>(node)->value);
+				break;
+
+			case Kind::Identifier:
+				index = Add(node->kind,
+					node->pos,
+					static_cast<const Identifier *>(node)->symbol.Id());
+				break;
+
+			case Kind::UnaryExpr:
+			{
+				const auto unaryExpr = static_cast<const UnaryExpr *>(node);
+				const auto entry = static_cast<std::uint32_t>(operations.size());
+				index = Add(node->kind, node->pos, entry);
+				operations.push_back({ noNode, noNode, Symbol(), unaryExpr->op });
+				stack.push_back({ unaryExpr->operand, { Slot::Field::Lhs, entry } });
+				break;
+			}
+
+			case Kind::BinaryExpr:
+			{
+				const auto binaryExpr = static_cast<const BinaryExpr *>(node);
+				const auto entry = static_cast<std::uint32_t>(operations.size());
+				index = Add(node->kind, node->pos, entry);
+				operations.push_back({ noNode, noNode, Symbol(), binaryExpr->op });
+				stack.push_back({ binaryExpr->rhs, { Slot::Field::Rhs, entry } });
+				stack.push_back({ binaryExpr->lhs, { Slot::Field::Lhs, entry } });
+				break;
+			}
+
+			case Kind::CastExpr:
+			{
+				const auto castExpr = static_cast<const CastExpr *>(node);
+				const auto entry = static_cast<std::uint32_t>(operations.size());
+				index = Add(node->kind, node->pos, entry);
+				operations.push_back({ noNode, noNode, castExpr->type, Token::Type::Cast });
+				stack.push_back({ castExpr->expr, { Slot::Field::Lhs, entry } });
+				break;
+			}
+		}
+
+		Link(slot, index);
+	}
+}
+
+auto FlatTree::Claim(const List<Statement *> &list, std::vector<Pending> &stack)
+	-> std::uint32_t
+{
+	const auto first = static_cast<std::uint32_t>(children.size());
+	children.resize(first + list.Size());
+
+	for (auto i = list.Size(); i > 0; --i)
+	{
+		stack.push_back({ list[i - 1], { Slot::Field::Child, first + i - 1 } });
+	}
+
+	ranges.push_back({ first, list.Size() });
+	return static_cast<std::uint32_t>(ranges.size() - 1);
+}
+
+auto FlatTree::Link(const Slot slot, const node_index_t node) -> void
+{
+	switch (slot.field)
+	{
+		case Slot::Field::None: break;
+		case Slot::Field::Child: children[slot.index] = node; break;
+		case Slot::Field::Payload: payloads[slot.index] = node; break;
+		case Slot::Field::Body: functions[slot.index].body = node; break;
+		case Slot::Field::Lhs: operations[slot.index].lhs = node; break;
+		case Slot::Field::Rhs: operations[slot.index].rhs = node; break;
+	}
+}
+
+}
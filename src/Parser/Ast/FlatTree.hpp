@@ -0,0 +1,198 @@
+/**
+ * @author ruarq
+ * @date 04.03.2022 
+ *
+ * Copyright (C) 2022 ruarq
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "../../Lexer/Token.hpp"
+#include "../../Symbol.hpp"
+#include "List.hpp"
+#include "Node.hpp"
+#include "TranslationUnit.hpp"
+
+namespace Lm::Ast
+{
+
+using node_index_t = std::uint32_t;
+
+/// Stands in for statements the parser couldn't make sense of
+constexpr node_index_t noNode = ~node_index_t(0);
+
+/**
+ * @brief The AST of a file in flat arrays, the alternative to the pointer tree that
+ * later passes can walk without chasing pointers.
+ *
+ * Nodes are numbered in pre-order, the translation unit is node 0. Every node has a
+ * kind, a position and a 32 bit payload that depends on the kind:
+ * - TranslationUnit, StmtBlock: index of its children in ranges
+ * - FunctionDecl: index into functions
+ * - ReturnStmt: the returned expression
+ * - Int32Expr: the value
+ * - Identifier: the symbol id
+ * - UnaryExpr, BinaryExpr, CastExpr: index into operations
+ *
+ * The children of a node are a contiguous range of node indices in children, which
+ * replaces the per node vectors of the pointer tree.
+ */
+class FlatTree final
+{
+public:
+	/**
+	 * @brief Children of a node, a range of children
+	 */
+	struct Range final
+	{
+		std::uint32_t first;
+		std::uint32_t size;
+	};
+
+	struct Function final
+	{
+		Symbol ident;
+		SourcePos identPos;
+		Symbol type;
+		node_index_t body;
+	};
+
+	/**
+	 * @brief Operator and operands of an expression. rhs is noNode for unary and
+	 * cast expressions, type is only valid for cast expressions.
+	 */
+	struct Operation final
+	{
+		node_index_t lhs;
+		node_index_t rhs;
+		Symbol type;
+		Token::Type op;
+	};
+
+public:
+	/**
+	 * @brief Convert the pointer tree of a file
+	 */
+	static auto FromTree(const TranslationUnit &unit) -> FlatTree;
+
+public:
+	/**
+	 * @brief Number of nodes
+	 */
+	inline auto Size() const -> size_t
+	{
+		return kinds.size();
+	}
+
+	/**
+	 * @brief Children of a TranslationUnit or StmtBlock node
+	 */
+	inline auto Children(const node_index_t node) const -> List<const node_index_t>
+	{
+		const auto range = ranges[payloads[node]];
+		return List<const node_index_t>(children.data() + range.first, range.size);
+	}
+
+	/**
+	 * @brief Side table entry of a FunctionDecl node
+	 */
+	inline auto GetFunction(const node_index_t node) const -> const Function &
+	{
+		return functions[payloads[node]];
+	}
+
+	/**
+	 * @brief Side table entry of a UnaryExpr, BinaryExpr or CastExpr node
+	 */
+	inline auto GetOperation(const node_index_t node) const -> const Operation &
+	{
+		return operations[payloads[node]];
+	}
+
+	/**
+	 * @brief Bytes used by the arrays
+	 */
+	auto Bytes() const -> size_t;
+
+public:
+	std::vector<Kind> kinds;
+	std::vector<SourcePos> positions;
+	std::vector<std::uint32_t> payloads;
+
+	std::vector<node_index_t> children;
+	std::vector<Range> ranges;
+	std::vector<Function> functions;
+	std::vector<Operation> operations;
+
+private:
+	/**
+	 * @brief Where the index of a converted node has to be stored
+	 */
+	struct Slot final
+	{
+		enum class Field : std::uint8_t
+		{
+			None,
+			Child,
+			Payload,
+			Body,
+			Lhs,
+			Rhs,
+		};
+
+		Field field;
+		std::uint32_t index;
+	};
+
+	/**
+	 * @brief Node of the pointer tree waiting to be converted
+	 */
+	struct Pending final
+	{
+		const Node *node;
+		Slot slot;
+	};
+
+private:
+	auto Add(const Kind kind, const SourcePos pos, const std::uint32_t payload) -> node_index_t;
+
+	/**
+	 * @brief Convert a node and everything below it. Uses a stack of its own, the
+	 * trees of long expressions are too deep to recurse on.
+	 */
+	auto Convert(const Node *root) -> void;
+
+	/**
+	 * @brief Claim a range for a list of children and queue them for conversion
+	 * @return The index of the range
+	 */
+	auto Claim(const List<Statement *> &list, std::vector<Pending> &stack) -> std::uint32_t;
+
+	/**
+	 * @brief Store the index of a converted node where its parent expects it
+	 */
+	auto Link(const Slot slot, const node_index_t node) -> void;
+};
+
+}
@@ -1,6 +1,6 @@
 /**
  * @author ruarq
- * @date 21.02.2022 
+ * @date 05.03.2022 
  *
  * Copyright (C) 2022 ruarq
  * 
@@ -23,17 +23,22 @@
  * IN THE SOFTWARE.
  */
 
-#include "StmtBlock.hpp"
+#include "FunctionDecl.hpp"
+
+#include "../LazyBodies.hpp"
 
 namespace Lm::Ast
 {
 
-StmtBlock::~StmtBlock()
+auto FunctionDecl::Body() -> StmtBlock *
 {
-	for (const auto stmt : statements)
+	if (lazy)
 	{
-		LM_DELETE(stmt);
+		statements = lazy->Parse(bodyBegin, bodyEnd);
+		lazy = nullptr;
 	}
+
+	return statements;
 }
 
 }
@@ -25,24 +25,57 @@
 
 #pragma once
 
-#include <string>
-#include <vector>
+#include <cstdint>
 
 #include "../../Symbol.hpp"
 #include "Identifier.hpp"
 #include "Statement.hpp"
 #include "StmtBlock.hpp"
 
+namespace Lm
+{
+class LazyBodies;
+}
+
 namespace Lm::Ast
 {
 
 class FunctionDecl final : public Statement
 {
+public:
+	static constexpr auto nodeKind = Kind::FunctionDecl;
+
+	constexpr FunctionDecl()
+		: Statement(nodeKind)
+	{
+	}
+
+public:
+	/**
+	 * @brief The body of the function. A body the parser skipped (see LazyBodies) gets
+	 * parsed here on first access.
+	 */
+	auto Body() -> StmtBlock *;
+
+	/**
+	 * @return True if the body was skipped and hasn't been parsed yet
+	 */
+	inline auto Skipped() const -> bool
+	{
+		return lazy != nullptr;
+	}
+
 public:
 	Identifier ident;
 	Symbol type;
 
-	StmtBlock *statements;
+	/// Null while the body is skipped, use Body() unless only parsed bodies matter
+	StmtBlock *statements = nullptr;
+
+	/// Parses the skipped body, tokens [bodyBegin, bodyEnd) of the token stream
+	LazyBodies *lazy = nullptr;
+	std::uint32_t bodyBegin = 0;
+	std::uint32_t bodyEnd = 0;
 };
 
 }
@@ -33,6 +33,14 @@ namespace Lm::Ast
 
 class Identifier final : public Expression
 {
+public:
+	static constexpr auto nodeKind = Kind::Identifier;
+
+	constexpr Identifier()
+		: Expression(nodeKind)
+	{
+	}
+
 public:
 	Symbol symbol;
 };
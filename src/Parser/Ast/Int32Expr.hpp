@@ -35,7 +35,15 @@ namespace Lm::Ast
 class Int32Expr final : public Expression
 {
 public:
-	uint32_t value;
+	static constexpr auto nodeKind = Kind::Int32Expr;
+
+	constexpr Int32Expr()
+		: Expression(nodeKind)
+	{
+	}
+
+public:
+	uint32_t value = 0;
 };
 
 }
@@ -0,0 +1,81 @@
+/**
+ * @author ruarq
+ * @date 03.03.2022 
+ *
+ * Copyright (C) 2022 ruarq
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+namespace Lm::Ast
+{
+
+/**
+ * @brief Children of a node, stored contiguously in the arena of the translation
+ * unit. Unlike std::vector it doesn't own its elements, which keeps nodes trivially
+ * destructible.
+ */
+template<typename T>
+class List final
+{
+public:
+	constexpr List() = default;
+
+	constexpr List(T *data, const std::uint32_t size)
+		: data(data)
+		, size(size)
+	{
+	}
+
+public:
+	inline auto Size() const -> std::uint32_t
+	{
+		return size;
+	}
+
+	inline auto Empty() const -> bool
+	{
+		return size == 0;
+	}
+
+	inline auto operator[](const std::uint32_t index) const -> T &
+	{
+		return data[index];
+	}
+
+	inline auto begin() const -> T *
+	{
+		return data;
+	}
+
+	inline auto end() const -> T *
+	{
+		return data + size;
+	}
+
+private:
+	T *data = nullptr;
+	std::uint32_t size = 0;
+};
+
+}
@@ -25,18 +25,56 @@
 
 #pragma once
 
+#include <cstdint>
+
 #include "../../Lexer/Token.hpp"
 
 namespace Lm::Ast
 {
 
+/**
+ * @brief Type of a node, every node stores its kind in place of a vtable
+ */
+enum class Kind : std::uint8_t
+{
+	TranslationUnit,
+	FunctionDecl,
+	StmtBlock,
+	ReturnStmt,
+	Int32Expr,
+	Identifier,
+	UnaryExpr,
+	BinaryExpr,
+	CastExpr,
+};
+
+/**
+ * @brief Base of all nodes. Nodes are allocated from the arena of their translation
+ * unit and never destructed (see TranslationUnit), so they have to stay trivially
+ * destructible: no virtual functions and no members that own memory.
+ */
 class Node
 {
 public:
-	virtual ~Node() = default;
+	constexpr Node(const Kind kind)
+		: pos({ .offset = 0 })
+		, kind(kind)
+	{
+	}
+
+public:
+	/**
+	 * @return True if the node is a T
+	 */
+	template<typename T>
+	inline auto Is() const -> bool
+	{
+		return kind == T::nodeKind;
+	}
 
 public:
 	SourcePos pos;
+	Kind kind;
 };
 
 }
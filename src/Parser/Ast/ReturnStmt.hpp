@@ -25,7 +25,6 @@
 
 #pragma once
 
-#include "../../Macros.hpp"
 #include "Expression.hpp"
 #include "Statement.hpp"
 
@@ -35,10 +34,15 @@ namespace Lm::Ast
 class ReturnStmt final : public Statement
 {
 public:
-	~ReturnStmt();
+	static constexpr auto nodeKind = Kind::ReturnStmt;
+
+	constexpr ReturnStmt()
+		: Statement(nodeKind)
+	{
+	}
 
 public:
-	Expression *expr;
+	Expression *expr = nullptr;
 };
 
 }
@@ -33,7 +33,7 @@ namespace Lm::Ast
 class Statement : public Node
 {
 public:
-	virtual ~Statement() = default;
+	using Node::Node;
 };
 
 }
@@ -25,25 +25,28 @@
 
 #pragma once
 
-#include <vector>
-
-#include "../../Macros.hpp"
-#include "Node.hpp"
+#include "List.hpp"
 #include "Statement.hpp"
 
 namespace Lm::Ast
 {
 
 /**
- * @brief Statement block, starts with { and ends with }
+ * @brief Statement block, starts with { and ends with }. Blocks are statements
+ * themselves, so they nest.
  */
-class StmtBlock final : public Node
+class StmtBlock final : public Statement
 {
 public:
-	~StmtBlock();
+	static constexpr auto nodeKind = Kind::StmtBlock;
+
+	constexpr StmtBlock()
+		: Statement(nodeKind)
+	{
+	}
 
 public:
-	std::vector<Statement *> statements;
+	List<Statement *> statements;
 };
 
 }
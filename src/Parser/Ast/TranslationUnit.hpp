@@ -25,22 +25,37 @@
 
 #pragma once
 
-#include <vector>
-
-#include "../../Macros.hpp"
+#include "../../Arena.hpp"
+#include "List.hpp"
 #include "Node.hpp"
 #include "Statement.hpp"
 
 namespace Lm::Ast
 {
 
+/**
+ * @brief Root of the AST of a file. Every other node of the file is allocated from
+ * the arena of the translation unit, in the order the parser creates them. Deleting
+ * the translation unit frees the whole tree at once, without visiting any node.
+ */
 class TranslationUnit final : public Node
 {
 public:
-	~TranslationUnit();
+	static constexpr auto nodeKind = Kind::TranslationUnit;
+
+	TranslationUnit()
+		: Node(nodeKind)
+	{
+	}
+
+	TranslationUnit(const TranslationUnit &) = delete;
+
+	auto operator=(const TranslationUnit &) -> TranslationUnit & = delete;
 
 public:
-	std::vector<Statement *> statements;
+	List<Statement *> statements;
+
+	Arena arena;
 };
 
 }
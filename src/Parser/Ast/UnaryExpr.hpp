@@ -0,0 +1,52 @@
+/**
+ * @author ruarq
+ * @date 05.03.2022 
+ *
+ * Copyright (C) 2022 ruarq
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include "../../Lexer/Token.hpp"
+#include "Expression.hpp"
+
+namespace Lm::Ast
+{
+
+/**
+ * @brief Prefix operator applied to an expression, e.g. -x or !x
+ */
+class UnaryExpr final : public Expression
+{
+public:
+	static constexpr auto nodeKind = Kind::UnaryExpr;
+
+	constexpr UnaryExpr()
+		: Expression(nodeKind)
+	{
+	}
+
+public:
+	Token::Type op = Token::Type::Unknown;
+	Expression *operand = nullptr;
+};
+
+}
@@ -0,0 +1,159 @@
+/**
+ * @author ruarq
+ * @date 05.03.2022 
+ *
+ * Copyright (C) 2022 ruarq
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "../Lexer/Token.hpp"
+
+/**
+ * @brief Binding powers of the operators for the expression parser (see
+ * Parser::Expression). An operator binds the operand between itself and its neighbour
+ * if its binding power on that side is higher. 0 means the token isn't an operator.
+ *
+ * From loosest to tightest:
+ * - = += -= *= /= %= &= |= ^= ~= <<= >>= (right associative)
+ * - ||
+ * - &&
+ * - |
+ * - ^
+ * - &
+ * - == !=
+ * - < > <= >=
+ * - << >>
+ * - + -
+ * - * / %
+ * - expr $ type
+ * - prefix + - ! ~
+ */
+namespace Lm::BindingPower
+{
+
+using power_t = std::uint8_t;
+
+/**
+ * @brief Binding powers of an infix operator. Left associative operators bind
+ * tighter to the right, right associative ones tighter to the left.
+ */
+struct Infix final
+{
+	power_t left = 0;
+	power_t right = 0;
+};
+
+constexpr auto tokenTypes = static_cast<std::size_t>(Token::Type::Eof) + 1;
+
+/// Left binding power of the postfix cast operator, its right side is a type
+constexpr power_t cast = 24;
+
+/// Right binding power of the prefix operators
+constexpr power_t prefix = 25;
+
+constexpr auto MakeInfixTable() -> std::array<Infix, tokenTypes>
+{
+	std::array<Infix, tokenTypes> table{};
+	const auto set = [&table](const Token::Type type, const power_t left, const power_t right) {
+		table[static_cast<std::size_t>(type)] = Infix{ left, right };
+	};
+
+	for (const auto type : { Token::Type::Assign,
+			 Token::Type::PlusEqual,
+			 Token::Type::MinusEqual,
+			 Token::Type::StarEqual,
+			 Token::Type::SlashEqual,
+			 Token::Type::ModEqual,
+			 Token::Type::AndEqual,
+			 Token::Type::OrEqual,
+			 Token::Type::XorEqual,
+			 Token::Type::FlipEqual,
+			 Token::Type::LShiftEqual,
+			 Token::Type::RShiftEqual })
+	{
+		set(type, 2, 1);
+	}
+
+	set(Token::Type::OrOr, 3, 4);
+	set(Token::Type::AndAnd, 5, 6);
+	set(Token::Type::Or, 7, 8);
+	set(Token::Type::Xor, 9, 10);
+	set(Token::Type::And, 11, 12);
+	set(Token::Type::Equal, 13, 14);
+	set(Token::Type::NotEqual, 13, 14);
+	set(Token::Type::Less, 15, 16);
+	set(Token::Type::Greater, 15, 16);
+	set(Token::Type::LessEqual, 15, 16);
+	set(Token::Type::GreaterEqual, 15, 16);
+	set(Token::Type::LShift, 17, 18);
+	set(Token::Type::RShift, 17, 18);
+	set(Token::Type::Plus, 19, 20);
+	set(Token::Type::Minus, 19, 20);
+	set(Token::Type::Star, 21, 22);
+	set(Token::Type::Slash, 21, 22);
+	set(Token::Type::Mod, 21, 22);
+
+	return table;
+}
+
+constexpr auto MakePrefixTable() -> std::array<bool, tokenTypes>
+{
+	std::array<bool, tokenTypes> table{};
+	for (const auto type :
+		{ Token::Type::Plus, Token::Type::Minus, Token::Type::Not, Token::Type::Flip })
+	{
+		table[static_cast<std::size_t>(type)] = true;
+	}
+	return table;
+}
+
+constexpr auto infixTable = MakeInfixTable();
+constexpr auto prefixTable = MakePrefixTable();
+
+/**
+ * @brief Binding powers of a token as an infix operator, both 0 if it isn't one
+ */
+constexpr auto OfInfix(const Token::Type type) -> Infix
+{
+	return infixTable[static_cast<std::size_t>(type)];
+}
+
+/**
+ * @return True if the token is a prefix operator
+ */
+constexpr auto IsPrefix(const Token::Type type) -> bool
+{
+	return prefixTable[static_cast<std::size_t>(type)];
+}
+
+static_assert(OfInfix(Token::Type::Star).left > OfInfix(Token::Type::Plus).right,
+	"* binds tighter than +");
+static_assert(OfInfix(Token::Type::Assign).left > OfInfix(Token::Type::Assign).right,
+	"assignments are right associative");
+static_assert(cast > OfInfix(Token::Type::Star).right && cast < prefix,
+	"-x $ i64 casts -x, a * b $ i64 casts b");
+
+}
@@ -1,6 +1,6 @@
 /**
  * @author ruarq
- * @date 16.02.2022 
+ * @date 05.03.2022 
  *
  * Copyright (C) 2022 ruarq
  * 
@@ -23,54 +23,33 @@
  * IN THE SOFTWARE.
  */
 
-#include "Symbol.hpp"
+#include "LazyBodies.hpp"
 
 namespace Lm
 {
 
-std::vector<std::string> Symbol::pool;
-std::unordered_map<std::string, symbol_id_t, MurmurHash> Symbol::stringToId;
-
-auto Symbol::NextId() -> symbol_id_t
-{
-	static symbol_id_t nextId = 0;
-	return nextId++;
-}
-
-auto Symbol::DropHashmap() -> void
+LazyBodies::LazyBodies(const TokenStream &stream,
+	const Diagnostics &diagnostics,
+	CompilationSession &session,
+	const size_t maxDepth)
+	: parser(stream, diagnostics, session, maxDepth)
 {
-	stringToId.clear();
 }
 
-Symbol::Symbol(std::string &&str)
+auto LazyBodies::Parse(const std::uint32_t begin, const std::uint32_t end) -> Ast::StmtBlock *
 {
-	operator=(std::move(str));
+	++parsed;
+	return parser.RunBody(*arena, begin, end);
 }
 
-auto Symbol::String() const -> const std::string &
+auto LazyBodies::Attach(Arena &arena) -> void
 {
-	return pool[id];
-}
-
-auto Symbol::operator=(std::string &&str) -> Symbol &
-{
-	if (stringToId.find(str) == stringToId.end())
-	{
-		id = NextId();
-		stringToId[str] = id;
-		pool.push_back(std::move(str));
-	}
-	else
-	{
-		id = stringToId.at(str);
-	}
-
-	return *this;
+	this->arena = &arena;
 }
 
-Symbol::operator bool() const
+auto LazyBodies::Parsed() const -> size_t
 {
-	return id != invalidId;
+	return parsed;
 }
 
 }
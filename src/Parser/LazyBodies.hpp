@@ -0,0 +1,82 @@
+/**
+ * @author ruarq
+ * @date 05.03.2022 
+ *
+ * Copyright (C) 2022 ruarq
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "../Arena.hpp"
+#include "../CompilationSession.hpp"
+#include "../Diagnostics.hpp"
+#include "../Lexer/TokenStream.hpp"
+#include "Parser.hpp"
+
+namespace Lm
+{
+
+/**
+ * @brief Parses function bodies on demand. A parser told to skip bodies (see
+ * Parser::SkipBodies) only records the token range of each body, found by brace
+ * matching, and FunctionDecl::Body() parses it through this on first access.
+ *
+ * Has to outlive the translation unit, and the token stream has to outlive both.
+ * Bodies get allocated from the arena of the translation unit. Diagnostics of a
+ * body show up when it's parsed. Not thread safe.
+ */
+class LazyBodies final
+{
+public:
+	LazyBodies(const TokenStream &stream,
+		const Diagnostics &diagnostics,
+		CompilationSession &session,
+		const size_t maxDepth = Parser::defaultMaxDepth);
+	LazyBodies(const LazyBodies &) = delete;
+
+	auto operator=(const LazyBodies &) -> LazyBodies & = delete;
+
+public:
+	/**
+	 * @brief Parse the body in tokens [begin, end)
+	 */
+	auto Parse(const std::uint32_t begin, const std::uint32_t end) -> Ast::StmtBlock *;
+
+	/**
+	 * @brief Set the arena bodies are allocated from, done by the parser
+	 */
+	auto Attach(Arena &arena) -> void;
+
+	/**
+	 * @brief Number of bodies parsed so far
+	 */
+	auto Parsed() const -> size_t;
+
+private:
+	Parser parser;
+	Arena *arena = nullptr;
+	size_t parsed = 0;
+};
+
+}
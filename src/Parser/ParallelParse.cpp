@@ -0,0 +1,144 @@
+/**
+ * @author ruarq
+ * @date 05.03.2022 
+ *
+ * Copyright (C) 2022 ruarq
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include "ParallelParse.hpp"
+
+#include <algorithm>
+
+#include "../Arena.hpp"
+#include "../Logger.hpp"
+#include "Parser.hpp"
+
+namespace Lm
+{
+
+namespace
+{
+
+/// Fewest tokens worth a task of their own, below that the task overhead shows
+constexpr size_t minTaskTokens = 16 * 1024;
+
+/// Tasks per thread, so threads that get the cheap parts pick up more
+constexpr size_t tasksPerThread = 8;
+
+/**
+ * @brief Part of a file parsed by one task
+ */
+struct Part final
+{
+	Arena arena;
+	Ast::List<Ast::Statement *> statements;
+	LogBuffer output;	 ///< Its diagnostics, printed in the order of the parts
+};
+
+}
+
+auto FindDeclarations(const TokenStream &stream) -> std::vector<size_t>
+{
+	std::vector<size_t> starts = { 0 };
+
+	size_t depth = 0;
+	for (size_t i = 0; i < stream.types.size(); ++i)
+	{
+		switch (stream.types[i])
+		{
+			case Token::Type::LCurly: ++depth; break;
+
+			// A stray } at the top level doesn't open anything for the next fn
+			case Token::Type::RCurly: depth -= depth > 0; break;
+
+			case Token::Type::Fn:
+				if (depth == 0 && i > 0)
+				{
+					starts.push_back(i);
+				}
+				break;
+
+			default: break;
+		}
+	}
+
+	return starts;
+}
+
+auto ParseParallel(const TokenStream &stream,
+	const Diagnostics &diagnostics,
+	CompilationSession &session,
+	ThreadPool &pool,
+	const size_t maxDepth) -> Ast::TranslationUnit *
+{
+	const auto declarations = FindDeclarations(stream);
+
+	// The eof token isn't part of any task, every task ends on an eof of its own
+	const auto eof = stream.Size() - 1;
+
+	// Cut the file at declaration starts into tasks of about the same size
+	const auto taskTokens = std::max(minTaskTokens, eof / (pool.Threads() * tasksPerThread));
+	std::vector<size_t> cuts = { 0 };
+	for (const auto start : declarations)
+	{
+		if (start - cuts.back() >= taskTokens)
+		{
+			cuts.push_back(start);
+		}
+	}
+	cuts.push_back(eof);
+
+	std::vector<Part> parts(cuts.size() - 1);
+	for (size_t i = 0; i < parts.size(); ++i)
+	{
+		pool.Submit([&, i] {
+			const auto previous = Logger::Redirected();
+			Logger::Redirect(&parts[i].output);
+
+			Parser parser(stream, diagnostics, session, maxDepth);
+			parts[i].statements = parser.RunRange(parts[i].arena, cuts[i], cuts[i + 1]);
+
+			Logger::Redirect(previous);
+		});
+	}
+	pool.Wait();
+
+	// Same output as parsing the file in one go
+	for (auto &part : parts)
+	{
+		Logger::Print(part.output.Take());
+	}
+
+	auto unit = new Ast::TranslationUnit();
+
+	std::vector<Ast::Statement *> statements;
+	for (auto &part : parts)
+	{
+		statements.insert(statements.end(), part.statements.begin(), part.statements.end());
+		unit->arena.Absorb(std::move(part.arena));
+	}
+
+	const auto size = static_cast<std::uint32_t>(statements.size());
+	unit->statements = Ast::List<Ast::Statement *>(unit->arena.Copy(statements.data(), size), size);
+	return unit;
+}
+
+}
@@ -0,0 +1,62 @@
+/**
+ * @author ruarq
+ * @date 05.03.2022 
+ *
+ * Copyright (C) 2022 ruarq
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "../CompilationSession.hpp"
+#include "../Diagnostics.hpp"
+#include "../Lexer/TokenStream.hpp"
+#include "../ThreadPool.hpp"
+#include "Ast/TranslationUnit.hpp"
+
+namespace Lm
+{
+
+/**
+ * @brief Find the top level declarations of a file by brace matching: every fn
+ * token outside of braces starts one. Only looks at the token types.
+ * @return Token index of the start of each declaration. The first declaration
+ * also gets the tokens in front of it, so the first index is always 0.
+ */
+auto FindDeclarations(const TokenStream &stream) -> std::vector<size_t>;
+
+/**
+ * @brief Parse a file on a thread pool. The top level declarations are split into
+ * tasks of similar size (see FindDeclarations), every task parses its part into an
+ * arena of its own and the results are put together in source order.
+ *
+ * Gives the same tree as Parser::Run, the symbols can get different ids though,
+ * tasks intern them in the order they get to them.
+ */
+auto ParseParallel(const TokenStream &stream,
+	const Diagnostics &diagnostics,
+	CompilationSession &session,
+	ThreadPool &pool,
+	const size_t maxDepth) -> Ast::TranslationUnit *;
+
+}
@@ -25,32 +25,134 @@
 
 #include "Parser.hpp"
 
+#include <algorithm>
+#include <charconv>
+
+#include "LazyBodies.hpp"
+
 namespace Lm
 {
 
-Parser::Parser(Lexer &lexer, const Diagnostics &diagnostics)
-	: lexer(lexer)
+namespace
+{
+
+/// Largest value of an i32 literal
+constexpr std::uint32_t maxInt32Literal = std::uint32_t(1) << 31;
+
+}
+
+Parser::Parser(Lexer<> &lexer,
+	const Diagnostics &diagnostics,
+	CompilationSession &session,
+	const size_t maxDepth)
+	: lexer(&lexer)
+	, stream(nullptr)
+	, pipe(nullptr)
+	, cursor(0)
 	, diagnostics(diagnostics)
+	, session(session)
+	, maxDepth(maxDepth)
+{
+}
+
+Parser::Parser(const TokenStream &stream,
+	const Diagnostics &diagnostics,
+	CompilationSession &session,
+	const size_t maxDepth)
+	: lexer(nullptr)
+	, stream(&stream)
+	, pipe(nullptr)
+	, cursor(0)
+	, diagnostics(diagnostics)
+	, session(session)
+	, maxDepth(maxDepth)
+{
+}
+
+Parser::Parser(TokenPipe &pipe,
+	const Diagnostics &diagnostics,
+	CompilationSession &session,
+	const size_t maxDepth)
+	: lexer(nullptr)
+	, stream(nullptr)
+	, pipe(&pipe)
+	, cursor(0)
+	, diagnostics(diagnostics)
+	, session(session)
+	, maxDepth(maxDepth)
 {
 }
 
 auto Parser::Run() -> Ast::TranslationUnit *
 {
 	auto unit = new Ast::TranslationUnit();
-	while ((curr = lexer.NextToken()).type != Token::Type::Eof)
+	arena = &unit->arena;
+
+	if (lazy)
 	{
-		unit->statements.push_back(GlobalStmt());
+		lazy->Attach(unit->arena);
 	}
+
+	curr = Fetch();
+	unit->statements = GlobalStmts();
 	return unit;
 }
 
+auto Parser::RunRange(Arena &arena, const size_t begin, const size_t end)
+	-> Ast::List<Ast::Statement *>
+{
+	this->arena = &arena;
+	cursor = begin;
+	last = end;
+
+	curr = Fetch();
+	return GlobalStmts();
+}
+
+auto Parser::RunBody(Arena &arena, const size_t begin, const size_t end) -> Ast::StmtBlock *
+{
+	this->arena = &arena;
+	cursor = begin;
+	last = end;
+
+	curr = Fetch();
+	return StmtBlock();
+}
+
+auto Parser::SkipBodies(LazyBodies &bodies) -> void
+{
+	if (stream)
+	{
+		lazy = &bodies;
+	}
+}
+
+auto Parser::GlobalStmts() -> Ast::List<Ast::Statement *>
+{
+	const auto first = pending.size();
+	while (!Eof())
+	{
+		pending.push_back(GlobalStmt());
+	}
+
+	return MakeList(first);
+}
+
 auto Parser::GlobalStmt() -> Ast::Statement *
 {
 	switch (curr.type)
 	{
 		case Token::Type::Fn: return FunctionDecl();
+
+		// A block without a function, skipped as a whole so it stays balanced
+		case Token::Type::LCurly:
+			diagnostics.Error(curr.pos, Locale::Get("PARSER_ERROR_UNEXPECTED_TOKEN"));
+			SkipBlock();
+			return nullptr;
+
 		default:
 			diagnostics.Error(curr.pos, Locale::Get("PARSER_ERROR_UNEXPECTED_TOKEN"));
+			Consume();
 			return nullptr;
 	}
 }
@@ -69,35 +171,135 @@ auto Parser::FunctionDecl() -> Ast::FunctionDecl *
 	if (curr.type == Token::Type::Arrow)
 	{
 		Consume();
-		fn->type = curr.symbol;
-		Consume(Token::Type::Int32, "i32");
+		// Any builtin type, like Cast. Anything else gets reported and skipped, unless
+		// it Synchronizes.
+		fn->type = Builtin::FromToken(curr.type);
+		if (fn->type)
+		{
+			Consume();
+		}
+		else
+		{
+			diagnostics.Error(curr.pos,
+				fmt::format(Locale::Get("PARSER_ERROR_EXPECTED_TOKEN"), "type"));
+			if (!Synchronizes(curr.type))
+			{
+				Consume();
+			}
+		}
 	}
 	else
 	{
-		// TODO(ruarq): Global constant for this
-		fn->type = Symbol("__void");
+		fn->type = Builtin::voidType;
 	}
 
-	fn->statements = StmtBlock();
+	// Only a real { opens the body, see Consume
+	if (curr.type == Token::Type::LCurly && lazy)
+	{
+		SkipBody(*fn);
+	}
+	else if (curr.type == Token::Type::LCurly)
+	{
+		fn->statements = StmtBlock();
+	}
+	else
+	{
+		diagnostics.Error(curr.pos,
+			fmt::format(Locale::Get("PARSER_ERROR_EXPECTED_TOKEN"), "{"));
+	}
 
 	return fn;
 }
 
 auto Parser::StmtBlock() -> Ast::StmtBlock *
 {
-	auto stmtBlock = Alloc<Ast::StmtBlock>();
-	stmtBlock->pos = curr.pos;
+	// Nested blocks are parsed in this loop, not by recursing into Statement.
+	// Statements of all open blocks pile up on pending.
+	const auto base = blocks.size();
+	OpenBlock();
 
-	Consume(Token::Type::LCurly, "{");
-
-	while (!Eof() && curr.type != Token::Type::RCurly)
+	while (true)
 	{
-		stmtBlock->statements.push_back(Statement());
+		if (Eof())
+		{
+			// Report the missing } once, not once per open block
+			diagnostics.Error(curr.pos,
+				fmt::format(Locale::Get("PARSER_ERROR_EXPECTED_TOKEN"), "}"));
+			while (blocks.size() > base + 1)
+			{
+				const auto block = CloseBlock();
+				pending.push_back(block);
+			}
+			return CloseBlock();
+		}
+
+		switch (curr.type)
+		{
+			case Token::Type::RCurly:
+			{
+				const auto block = CloseBlock();
+				Consume();
+				if (blocks.size() == base)
+				{
+					return block;
+				}
+				pending.push_back(block);
+				break;
+			}
+
+			case Token::Type::LCurly:
+				if (TooDeep())
+				{
+					SkipBlock();
+				}
+				else
+				{
+					OpenBlock();
+				}
+				break;
+
+			default: pending.push_back(Statement()); break;
+		}
 	}
+}
+
+auto Parser::SkipBody(Ast::FunctionDecl &fn) -> void
+{
+	// Parsing the body later stops at the same } (see Consume), unless the file ends
+	// first. The tokens in between are never put together.
+	const auto end = std::min(last, stream->Size() - 1);
+	const auto begin = cursor - 1;
+
+	auto index = begin;
+	size_t depth = 0;
+	do
+	{
+		const auto type = stream->types[index++];
+		depth += type == Token::Type::LCurly;
+		depth -= type == Token::Type::RCurly;
+	} while (depth && index < end);
 
-	Consume(Token::Type::RCurly, "}");
+	fn.lazy = lazy;
+	fn.bodyBegin = static_cast<std::uint32_t>(begin);
+	fn.bodyEnd = static_cast<std::uint32_t>(index);
 
-	return stmtBlock;
+	cursor = index;
+	curr = Fetch();
+}
+
+auto Parser::OpenBlock() -> void
+{
+	const auto stmtBlock = Alloc<Ast::StmtBlock>();
+	Consume(Token::Type::LCurly, "{");
+	blocks.push_back({ stmtBlock, pending.size() });
+}
+
+auto Parser::CloseBlock() -> Ast::StmtBlock *
+{
+	const auto block = blocks.back();
+	blocks.pop_back();
+	block.node->statements = MakeList(block.first);
+	return block.node;
 }
 
 auto Parser::Statement() -> Ast::Statement *
@@ -107,6 +309,8 @@ auto Parser::Statement() -> Ast::Statement *
 		case Token::Type::Ret: return ReturnStmt();
 		default:
 			diagnostics.Error(curr.pos, Locale::Get("PARSER_ERROR_UNEXPECTED_TOKEN"));
+			// Skip the token, else the enclosing block would never make progress
+			Consume();
 			return nullptr;
 	}
 }
@@ -121,6 +325,102 @@ auto Parser::ReturnStmt() -> Ast::ReturnStmt *
 }
 
 auto Parser::Expression() -> Ast::Expression *
+{
+	// Operators wait on the stack until one that binds looser follows them. That's
+	// Pratt parsing without the recursion: linear in the number of tokens and no
+	// native stack growth however long or deeply nested the expression is.
+	const auto operandBase = operands.size();
+	const auto operatorBase = operators.size();
+	size_t groups = 0;
+
+	while (true)
+	{
+		while (BindingPower::IsPrefix(curr.type) || curr.type == Token::Type::LParen)
+		{
+			if (TooDeep())
+			{
+				operands.resize(operandBase);
+				operators.resize(operatorBase);
+				SkipExpression();
+				return nullptr;
+			}
+
+			if (curr.type == Token::Type::LParen)
+			{
+				operators.push_back({ curr.pos, curr.type, 0, 0 });
+				++groups;
+			}
+			else
+			{
+				operators.push_back({ curr.pos, curr.type, BindingPower::prefix, 1 });
+			}
+			Consume();
+		}
+
+		const auto operand = Primary();
+		if (!operand)
+		{
+			operands.resize(operandBase);
+			operators.resize(operatorBase);
+			return nullptr;
+		}
+		operands.push_back(operand);
+
+		// Postfix operators and closing parentheses, until an infix operator follows
+		// the operand or the expression ends
+		while (curr.type == Token::Type::Cast || (curr.type == Token::Type::RParen && groups))
+		{
+			if (curr.type == Token::Type::Cast)
+			{
+				ReduceAbove(BindingPower::cast, operatorBase);
+				Cast();
+			}
+			else
+			{
+				ReduceAbove(0, operatorBase);
+				operators.pop_back();
+				--groups;
+				Consume();
+			}
+		}
+
+		const auto infix = BindingPower::OfInfix(curr.type);
+		if (!infix.left)
+		{
+			break;
+		}
+
+		ReduceAbove(infix.left, operatorBase);
+		if (TooDeep())
+		{
+			operands.resize(operandBase);
+			operators.resize(operatorBase);
+			SkipExpression();
+			return nullptr;
+		}
+		operators.push_back({ curr.pos, curr.type, infix.right, 2 });
+		Consume();
+	}
+
+	if (groups)
+	{
+		diagnostics.Error(curr.pos, fmt::format(Locale::Get("PARSER_ERROR_EXPECTED_TOKEN"), ")"));
+	}
+
+	// Close whatever parentheses are still open
+	ReduceAbove(0, operatorBase);
+	while (operators.size() > operatorBase)
+	{
+		operators.pop_back();
+		ReduceAbove(0, operatorBase);
+	}
+
+	const auto expr = operands.back();
+	operands.pop_back();
+	return expr;
+}
+
+auto Parser::Primary() -> Ast::Expression *
 {
 	switch (curr.type)
 	{
@@ -128,25 +428,128 @@ auto Parser::Expression() -> Ast::Expression *
 		{
 			auto int32Expr = Alloc<Ast::Int32Expr>();
 			const auto tok = Consume(Token::Type::Int32Literal, "i32 literal");
-			if (tok.symbol)
+			const auto text = Text(tok);
+			const auto [end, error] =
+				std::from_chars(text.data(), text.data() + text.size(), int32Expr->value);
+
+			// Literals have no sign, 2^31 is allowed for the magnitude of the lowest i32
+			if (error == std::errc::result_out_of_range || int32Expr->value > maxInt32Literal)
 			{
-				int32Expr->value = std::stoi(tok.symbol.String());
+				diagnostics.Error(tok.pos,
+					fmt::format(Locale::Get("PARSER_ERROR_INT32_OUT_OF_RANGE"), text));
+			}
+			else if (error != std::errc() || end != text.data() + text.size())
+			{
+				diagnostics.Error(tok.pos,
+					fmt::format(Locale::Get("PARSER_ERROR_INVALID_INT32"), text));
 			}
 			return int32Expr;
 		}
 
+		case Token::Type::Ident: return arena->New<Ast::Identifier>(Ident());
+
 		default:
 			diagnostics.Error(curr.pos, Locale::Get("PARSER_ERROR_UNEXPECTED_TOKEN"));
 			return nullptr;
 	}
 }
 
+auto Parser::Cast() -> void
+{
+	auto castExpr = Alloc<Ast::CastExpr>();
+	Consume(Token::Type::Cast, "$");
+
+	castExpr->type = Builtin::FromToken(curr.type);
+	if (castExpr->type)
+	{
+		Consume();
+	}
+	else
+	{
+		// Leave the token alone, it most likely belongs to whatever follows
+		diagnostics.Error(curr.pos,
+			fmt::format(Locale::Get("PARSER_ERROR_EXPECTED_TOKEN"), "type"));
+	}
+
+	castExpr->expr = operands.back();
+	operands.back() = castExpr;
+}
+
+auto Parser::ReduceAbove(const BindingPower::power_t power, const size_t base) -> void
+{
+	while (operators.size() > base && operators.back().right > power)
+	{
+		const auto op = operators.back();
+		operators.pop_back();
+
+		if (op.arity == 1)
+		{
+			auto unaryExpr = arena->New<Ast::UnaryExpr>();
+			unaryExpr->pos = op.pos;
+			unaryExpr->op = op.type;
+			unaryExpr->operand = operands.back();
+			operands.back() = unaryExpr;
+		}
+		else
+		{
+			auto binaryExpr = arena->New<Ast::BinaryExpr>();
+			binaryExpr->pos = op.pos;
+			binaryExpr->op = op.type;
+			binaryExpr->rhs = operands.back();
+			operands.pop_back();
+			binaryExpr->lhs = operands.back();
+			operands.back() = binaryExpr;
+		}
+	}
+}
+
+auto Parser::TooDeep() -> bool
+{
+	if (blocks.size() + operators.size() < maxDepth)
+	{
+		return false;
+	}
+
+	diagnostics.Error(curr.pos,
+		fmt::format(Locale::Get("PARSER_ERROR_NESTING_TOO_DEEP"), maxDepth));
+	return true;
+}
+
+auto Parser::SkipBlock() -> void
+{
+	Consume(Token::Type::LCurly, "{");
+	for (size_t open = 1; open && !Eof(); Consume())
+	{
+		if (curr.type == Token::Type::LCurly)
+		{
+			++open;
+		}
+		else if (curr.type == Token::Type::RCurly)
+		{
+			--open;
+		}
+	}
+}
+
+auto Parser::SkipExpression() -> void
+{
+	while (curr.type != Token::Type::Semicolon && !Synchronizes(curr.type))
+	{
+		Consume();
+	}
+}
+
 auto Parser::Ident() -> Ast::Identifier
 {
 	Ast::Identifier ident;
 	ident.pos = curr.pos;
 	const auto tok = Consume(Token::Type::Ident, "identifier");
-	ident.symbol = tok.symbol;
+	if (tok.type == Token::Type::Ident)
+	{
+		// Identifiers are interned here with the hash the lexer computed, the lexer
+		// doesn't allocate anything
+		ident.symbol = session.Intern(Text(tok), tok.hash);
+	}
 	return ident;
 }
 
@@ -156,18 +559,74 @@ auto Parser::Consume(const Token::Type type, const std::string &expected) -> Tok
 	{
 		diagnostics.Error(curr.pos,
 			fmt::format(Locale::Get("PARSER_ERROR_EXPECTED_TOKEN"), expected));
+
+		// Braces and fn are left for the parts of the parser that handle them. That
+		// keeps the blocks the parser sees the same as the braces in the source, and
+		// every fn outside of braces starts a declaration (see FindDeclarations).
+		if (Synchronizes(curr.type))
+		{
+			return curr;
+		}
 	}
 
 	return Consume();
 }
 
+auto Parser::Synchronizes(const Token::Type type) -> bool
+{
+	return type == Token::Type::LCurly || type == Token::Type::RCurly
+		|| type == Token::Type::Fn || type == Token::Type::Eof;
+}
+
+auto Parser::MakeList(const size_t first) -> Ast::List<Ast::Statement *>
+{
+	const auto size = pending.size() - first;
+	const auto data = arena->Copy(pending.data() + first, size);
+	pending.resize(first);
+	return Ast::List<Ast::Statement *>(data, static_cast<std::uint32_t>(size));
+}
+
 auto Parser::Consume() -> Token
 {
 	const auto ret = curr;
-	curr = lexer.NextToken();
+	curr = Fetch();
 	return ret;
 }
 
+auto Parser::Fetch() -> Token
+{
+	if (stream)
+	{
+		if (cursor < last)
+		{
+			return (*stream)[cursor++];
+		}
+
+		// The end of a range reads as eof at the position of the token after it
+		auto eof = (*stream)[last];
+		eof.type = Token::Type::Eof;
+		eof.hash = 0;
+		return eof;
+	}
+
+	if (pipe)
+	{
+		return pipe->NextToken();
+	}
+
+	return lexer->NextToken();
+}
+
+auto Parser::Text(const Token &token) const -> std::string_view
+{
+	if (stream)
+	{
+		return stream->Text(token);
+	}
+
+	return pipe ? pipe->Text(token) : lexer->Text(token);
+}
+
 auto Parser::Eof() const -> bool
 {
 	return curr.type == Token::Type::Eof;
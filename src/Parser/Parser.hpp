@@ -25,66 +25,254 @@
 
 #pragma once
 
+#include <limits>
+#include <string_view>
 #include <vector>
 
+#include "../Arena.hpp"
+#include "../Builtins.hpp"
+#include "../CompilationSession.hpp"
 #include "../Diagnostics.hpp"
 #include "../Lexer/Lexer.hpp"
 #include "../Lexer/Token.hpp"
+#include "../Lexer/TokenPipe.hpp"
+#include "../Lexer/TokenStream.hpp"
+#include "Ast/BinaryExpr.hpp"
+#include "Ast/CastExpr.hpp"
 #include "Ast/Expression.hpp"
 #include "Ast/FunctionDecl.hpp"
 #include "Ast/Identifier.hpp"
 #include "Ast/Int32Expr.hpp"
+#include "Ast/List.hpp"
 #include "Ast/Node.hpp"
 #include "Ast/ReturnStmt.hpp"
 #include "Ast/StmtBlock.hpp"
 #include "Ast/TranslationUnit.hpp"
+#include "Ast/UnaryExpr.hpp"
+#include "BindingPower.hpp"
 
 namespace Lm
 {
 
+class LazyBodies;
+
 class Parser final
 {
+private:
+	/**
+	 * @brief Operator waiting for its right operand (see Expression)
+	 */
+	struct Operator final
+	{
+		SourcePos pos;
+		Token::Type type;
+		BindingPower::power_t right;
+		std::uint8_t arity;		///< 1 for prefix operators, 2 for infix ones, 0 for (
+	};
+
+	/**
+	 * @brief Block whose statements are being parsed (see StmtBlock)
+	 */
+	struct Block final
+	{
+		Ast::StmtBlock *node;
+		size_t first;	 ///< Where its statements start on pending
+	};
+
 public:
-	Parser(Lexer &lexer, const Diagnostics &diagnostics);
+	/// Deepest nesting of blocks and pending operators the parser accepts by default.
+	/// The parser itself doesn't recurse, the limit is for the passes after it.
+	static constexpr size_t defaultMaxDepth = 256;
+
+public:
+	/**
+	 * @brief Parse tokens as the lexer produces them
+	 */
+	Parser(Lexer<> &lexer,
+		const Diagnostics &diagnostics,
+		CompilationSession &session,
+		const size_t maxDepth = defaultMaxDepth);
+
+	/**
+	 * @brief Parse a file that has been tokenized already
+	 */
+	Parser(const TokenStream &stream,
+		const Diagnostics &diagnostics,
+		CompilationSession &session,
+		const size_t maxDepth = defaultMaxDepth);
+
+	/**
+	 * @brief Parse tokens as a lexer on another thread produces them
+	 */
+	Parser(TokenPipe &pipe,
+		const Diagnostics &diagnostics,
+		CompilationSession &session,
+		const size_t maxDepth = defaultMaxDepth);
 
 public:
 	auto Run() -> Ast::TranslationUnit *;
 
+	/**
+	 * @brief Parse the top level statements in tokens [begin, end) of the token stream
+	 * into an arena. Lets parts of a file be parsed in parallel (see ParseParallel).
+	 */
+	auto RunRange(Arena &arena, const size_t begin, const size_t end)
+		-> Ast::List<Ast::Statement *>;
+
+	/**
+	 * @brief Parse the function body in tokens [begin, end) of the token stream into an
+	 * arena (see LazyBodies)
+	 */
+	auto RunBody(Arena &arena, const size_t begin, const size_t end) -> Ast::StmtBlock *;
+
+	/**
+	 * @brief Only record the token ranges of function bodies, bodies parses them once
+	 * they're needed. Takes effect when parsing a token stream.
+	 */
+	auto SkipBodies(LazyBodies &bodies) -> void;
+
 private:
+	/**
+	 * @brief Parse top level statements until eof
+	 */
+	auto GlobalStmts() -> Ast::List<Ast::Statement *>;
+
 	auto GlobalStmt() -> Ast::Statement *;
 	auto FunctionDecl() -> Ast::FunctionDecl *;
+	/**
+	 * @brief Parse a block and the blocks nested in it, without recursion
+	 */
 	auto StmtBlock() -> Ast::StmtBlock *;
+
+	/**
+	 * @brief Skip the body of a function by brace matching on the token types and
+	 * record its range
+	 */
+	auto SkipBody(Ast::FunctionDecl &fn) -> void;
+
+	/**
+	 * @brief Open a block nested in the blocks being parsed
+	 */
+	auto OpenBlock() -> void;
+
+	/**
+	 * @brief Close the innermost open block, its statements move into the arena
+	 */
+	auto CloseBlock() -> Ast::StmtBlock *;
 	auto Statement() -> Ast::Statement *;
 	auto ReturnStmt() -> Ast::ReturnStmt *;
 
+	/**
+	 * @brief Parse an expression with the binding powers of BindingPower
+	 */
 	auto Expression() -> Ast::Expression *;
 
+	/**
+	 * @brief Parse a literal or an identifier
+	 */
+	auto Primary() -> Ast::Expression *;
+
+	/**
+	 * @brief Apply $ type to the operand on top of the stack
+	 */
+	auto Cast() -> void;
+
+	/**
+	 * @brief Combine the operators above base that bind tighter than power with
+	 * their operands
+	 */
+	auto ReduceAbove(const BindingPower::power_t power, const size_t base) -> void;
+
+	/**
+	 * @brief Check if one more level of nesting would exceed maxDepth, reports it if so
+	 */
+	auto TooDeep() -> bool;
+
+	/**
+	 * @brief Skip a block including everything nested in it
+	 */
+	auto SkipBlock() -> void;
+
+	/**
+	 * @brief Skip to the end of the statement
+	 */
+	auto SkipExpression() -> void;
+
 	inline auto Ident() -> Ast::Identifier;
 
 	/**
-	 * @brief Consume a specific token type
+	 * @brief Consume a specific token type. Any other token is reported and consumed
+	 * in its place, unless it Synchronizes.
 	 */
 	auto Consume(const Token::Type type, const std::string &expected) -> Token;
 
+	/**
+	 * @return True if the token is one error recovery never skips
+	 */
+	static inline auto Synchronizes(const Token::Type type) -> bool;
+
 	/**
 	 * @brief Consume any token
 	 */
 	inline auto Consume() -> Token;
 
+	/**
+	 * @brief Get the next token from the lexer, the token stream or the token pipe
+	 */
+	inline auto Fetch() -> Token;
+
+	/**
+	 * @brief View the text of a token in the source
+	 */
+	inline auto Text(const Token &token) const -> std::string_view;
+
 	inline auto Eof() const -> bool;
 
+	/**
+	 * @brief Move the statements pushed onto pending since first into the arena
+	 */
+	auto MakeList(const size_t first) -> Ast::List<Ast::Statement *>;
+
 	template<typename T>
 	inline auto Alloc() -> T *
 	{
-		auto node = new T();
+		auto node = arena->New<T>();
 		node->pos = curr.pos;
 		return node;
 	}
 
 private:
-	Lexer &lexer;
+	Lexer<> *lexer;
+	const TokenStream *stream;
+	TokenPipe *pipe;
+	size_t cursor;
+
+	/// Tokens of the stream from here on read as eof (see RunRange)
+	size_t last = std::numeric_limits<size_t>::max();
+
+	/// Parses the bodies that get skipped, null if bodies are parsed right away
+	LazyBodies *lazy = nullptr;
+
 	const Diagnostics &diagnostics;
+	CompilationSession &session;
 	Token curr;
+
+	/// Arena of the translation unit being parsed
+	Arena *arena = nullptr;
+
+	/// Statements of the blocks being parsed, a block takes its statements off the
+	/// top when it's done
+	std::vector<Ast::Statement *> pending;
+
+	/// Blocks being parsed, innermost last
+	std::vector<Block> blocks;
+
+	/// Operands and operators of the expression being parsed
+	std::vector<Ast::Expression *> operands;
+	std::vector<Operator> operators;
+
+	/// Limit for the size of blocks and operators together
+	size_t maxDepth;
 };
 
 }
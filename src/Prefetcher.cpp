@@ -0,0 +1,106 @@
+/**
+ * @author ruarq
+ * @date 05.03.2022 
+ *
+ * Copyright (C) 2022 ruarq
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include "Prefetcher.hpp"
+
+#include <algorithm>
+
+namespace Lm
+{
+
+Prefetcher::Prefetcher(const std::vector<std::string> &filenames,
+	const File::LoadMode mode,
+	const size_t budget)
+	: filenames(filenames)
+	, mode(mode)
+	, budget(budget)
+	, thread(&Prefetcher::Load, this)
+{
+}
+
+Prefetcher::~Prefetcher()
+{
+	{
+		std::lock_guard lock(mutex);
+		stop = true;
+	}
+	room.notify_all();
+	thread.join();
+}
+
+auto Prefetcher::Next() -> std::unique_ptr<File>
+{
+	std::unique_lock lock(mutex);
+	if (ready.empty())
+	{
+		const auto start = std::chrono::steady_clock::now();
+		loaded.wait(lock, [this] { return !ready.empty(); });
+		++stats.waits;
+		stats.time += std::chrono::steady_clock::now() - start;
+	}
+
+	auto file = std::move(ready.front());
+	ready.pop_front();
+	held -= file->Size();
+
+	lock.unlock();
+	room.notify_one();
+	return file;
+}
+
+auto Prefetcher::Stats() const -> LoadStats
+{
+	std::lock_guard lock(mutex);
+	return stats;
+}
+
+auto Prefetcher::Load() -> void
+{
+	for (const auto &filename : filenames)
+	{
+		{
+			std::unique_lock lock(mutex);
+			room.wait(lock, [this] { return stop || ready.empty() || held < budget; });
+			if (stop)
+			{
+				return;
+			}
+		}
+
+		// Files that can't be loaded are handed on as well, Next() stays in order
+		auto file = std::make_unique<File>(filename, mode);
+		file->Prefault();
+
+		{
+			std::lock_guard lock(mutex);
+			held += file->Size();
+			stats.peak = std::max(stats.peak, held);
+			ready.push_back(std::move(file));
+		}
+		loaded.notify_one();
+	}
+}
+
+}
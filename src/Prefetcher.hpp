@@ -0,0 +1,109 @@
+/**
+ * @author ruarq
+ * @date 05.03.2022 
+ *
+ * Copyright (C) 2022 ruarq
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "File.hpp"
+
+namespace Lm
+{
+
+/**
+ * @brief Loads the input files on a background thread, in the order they get
+ * compiled, so the compiler doesn't wait for the disk between files. Mapped files
+ * get prefaulted (see File::Prefault).
+ *
+ * The thread stops reading ahead while the files waiting to be taken hold budget
+ * bytes or more, a single file bigger than that still gets loaded.
+ */
+class Prefetcher final
+{
+public:
+	/**
+	 * @brief How often and how long Next() waited for a file
+	 */
+	struct LoadStats final
+	{
+		size_t waits = 0;
+		std::chrono::nanoseconds time{ 0 };
+		size_t peak = 0;	///< Most bytes held by loaded files at once
+	};
+
+public:
+	/**
+	 * @brief Start loading filenames
+	 */
+	Prefetcher(const std::vector<std::string> &filenames,
+		const File::LoadMode mode,
+		const size_t budget);
+	Prefetcher(const Prefetcher &) = delete;
+	~Prefetcher();
+
+	auto operator=(const Prefetcher &) -> Prefetcher & = delete;
+
+public:
+	/**
+	 * @brief Take the next file of the list, waits until it's loaded
+	 */
+	auto Next() -> std::unique_ptr<File>;
+
+	/**
+	 * @brief How the read-ahead went so far
+	 */
+	auto Stats() const -> LoadStats;
+
+private:
+	/**
+	 * @brief Body of the loading thread
+	 */
+	auto Load() -> void;
+
+private:
+	const std::vector<std::string> filenames;
+	const File::LoadMode mode;
+	const size_t budget;
+
+	mutable std::mutex mutex;
+	std::condition_variable loaded;	   ///< Signaled when a file is ready
+	std::condition_variable room;	   ///< Signaled when a file was taken or on stop
+	std::deque<std::unique_ptr<File>> ready;
+	size_t held = 0;	///< Bytes of the files in ready
+	bool stop = false;
+	LoadStats stats;
+
+	std::thread thread;
+};
+
+}
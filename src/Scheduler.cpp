@@ -0,0 +1,126 @@
+/**
+ * @author ruarq
+ * @date 05.03.2022 
+ *
+ * Copyright (C) 2022 ruarq
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include "Scheduler.hpp"
+
+#include <algorithm>
+#include <thread>
+#include <utility>
+
+namespace Lm
+{
+
+Scheduler::Scheduler(const size_t threads)
+	: queues(std::max<size_t>(threads, 1))
+	, stats(queues.size())
+{
+}
+
+auto Scheduler::Run(std::vector<Task> tasks) -> void
+{
+	for (size_t i = 0; i < tasks.size(); ++i)
+	{
+		queues[i % queues.size()].tasks.push_back(std::move(tasks[i]));
+	}
+	std::fill(stats.begin(), stats.end(), WorkerStats());
+
+	const auto start = std::chrono::steady_clock::now();
+
+	// No task adds new ones, a worker that finds every queue empty is done
+	std::vector<std::thread> workers;
+	workers.reserve(queues.size());
+	for (size_t worker = 0; worker < queues.size(); ++worker)
+	{
+		workers.emplace_back(&Scheduler::Work, this, worker);
+	}
+
+	for (auto &worker : workers)
+	{
+		worker.join();
+	}
+
+	elapsed = std::chrono::steady_clock::now() - start;
+}
+
+auto Scheduler::Threads() const -> size_t
+{
+	return queues.size();
+}
+
+auto Scheduler::Stats() const -> const std::vector<WorkerStats> &
+{
+	return stats;
+}
+
+auto Scheduler::Elapsed() const -> std::chrono::nanoseconds
+{
+	return elapsed;
+}
+
+auto Scheduler::Work(const size_t worker) -> void
+{
+	auto &own = stats[worker];
+
+	Task task;
+	while (Take(worker, task))
+	{
+		const auto start = std::chrono::steady_clock::now();
+		task();
+		own.busy += std::chrono::steady_clock::now() - start;
+		++own.tasks;
+	}
+}
+
+auto Scheduler::Take(const size_t worker, Task &task) -> bool
+{
+	{
+		auto &queue = queues[worker];
+		std::lock_guard lock(queue.mutex);
+		if (!queue.tasks.empty())
+		{
+			task = std::move(queue.tasks.front());
+			queue.tasks.pop_front();
+			return true;
+		}
+	}
+
+	// The back of a queue holds the tasks its owner would get to last
+	for (size_t i = 1; i < queues.size(); ++i)
+	{
+		auto &queue = queues[(worker + i) % queues.size()];
+		std::lock_guard lock(queue.mutex);
+		if (!queue.tasks.empty())
+		{
+			task = std::move(queue.tasks.back());
+			queue.tasks.pop_back();
+			++stats[worker].steals;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+}
@@ -0,0 +1,104 @@
+/**
+ * @author ruarq
+ * @date 05.03.2022 
+ *
+ * Copyright (C) 2022 ruarq
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+namespace Lm
+{
+
+/**
+ * @brief Runs a fixed set of tasks on worker threads with a queue each. A worker
+ * takes tasks from the front of its own queue and steals from the back of the
+ * others' once it runs dry.
+ */
+class Scheduler final
+{
+public:
+	using Task = std::function<void()>;
+
+	/**
+	 * @brief What a worker did during Run()
+	 */
+	struct WorkerStats final
+	{
+		size_t tasks = 0;
+		size_t steals = 0;	  ///< Tasks it took from other workers
+		std::chrono::nanoseconds busy{ 0 };
+	};
+
+public:
+	explicit Scheduler(const size_t threads);
+
+public:
+	/**
+	 * @brief Run the tasks and wait for all of them. Task i is queued on worker
+	 * i % threads, so tasks early in the list start first.
+	 */
+	auto Run(std::vector<Task> tasks) -> void;
+
+	/**
+	 * @brief Number of worker threads
+	 */
+	auto Threads() const -> size_t;
+
+	/**
+	 * @brief What each worker did during the last Run()
+	 */
+	auto Stats() const -> const std::vector<WorkerStats> &;
+
+	/**
+	 * @brief Wall time of the last Run()
+	 */
+	auto Elapsed() const -> std::chrono::nanoseconds;
+
+private:
+	struct Queue final
+	{
+		std::mutex mutex;
+		std::deque<Task> tasks;
+	};
+
+private:
+	auto Work(const size_t worker) -> void;
+
+	/**
+	 * @brief Take a task from the worker's own queue, or steal one
+	 */
+	auto Take(const size_t worker, Task &task) -> bool;
+
+private:
+	std::vector<Queue> queues;
+	std::vector<WorkerStats> stats;
+	std::chrono::nanoseconds elapsed{ 0 };
+};
+
+}
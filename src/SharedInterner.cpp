@@ -0,0 +1,180 @@
+/**
+ * @author ruarq
+ * @date 25.02.2022 
+ *
+ * Copyright (C) 2022 ruarq
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include "SharedInterner.hpp"
+
+#include <algorithm>
+#include <mutex>
+
+namespace Lm
+{
+
+template<typename HashPolicy>
+SharedInterner<HashPolicy>::SharedInterner(const std::vector<std::string_view> &reserved,
+	const HashPolicy &hasher)
+	: hasher(hasher)
+{
+	for (symbol_id_t id = 0; id < reserved.size(); ++id)
+	{
+		const auto hash = static_cast<std::uint32_t>(hasher(reserved[id]));
+		const auto shardIndex = ShardOf(hash);
+		auto &shard = shards[shardIndex];
+
+		const auto index = shard.interner.Intern(reserved[id], hash);
+		shard.reserved.push_back(id);
+		reservedLocal.push_back((index << shardBits) | shardIndex);
+	}
+}
+
+template<typename HashPolicy>
+auto SharedInterner<HashPolicy>::Intern(const std::string_view str) -> symbol_id_t
+{
+	return Intern(str, static_cast<std::uint32_t>(hasher(str)));
+}
+
+template<typename HashPolicy>
+auto SharedInterner<HashPolicy>::Intern(const std::string_view str, const std::uint32_t hash)
+	-> symbol_id_t
+{
+	if (isFrozen)
+	{
+		return notInterned;
+	}
+
+	const auto shardIndex = ShardOf(hash);
+	auto &shard = shards[shardIndex];
+
+	auto id = notInterned;
+	{
+		std::shared_lock lock(shard.mutex);
+		id = shard.interner.Find(str, hash);
+	}
+
+	if (id == notInterned)
+	{
+		// Intern() probes again, someone else might have added the string in between
+		std::unique_lock lock(shard.mutex);
+		id = shard.interner.Intern(str, hash);
+	}
+
+	return Encode(shardIndex, id);
+}
+
+template<typename HashPolicy>
+auto SharedInterner<HashPolicy>::Find(const std::string_view str) const -> symbol_id_t
+{
+	const auto hash = static_cast<std::uint32_t>(hasher(str));
+
+	if (isFrozen)
+	{
+		auto entry = std::lower_bound(frozen.begin(),
+			frozen.end(),
+			hash,
+			[](const FrozenEntry &entry, const std::uint32_t hash) { return entry.hash < hash; });
+
+		for (; entry != frozen.end() && entry->hash == hash; ++entry)
+		{
+			if (Get(entry->id) == str)
+			{
+				return entry->id;
+			}
+		}
+
+		return notInterned;
+	}
+
+	const auto shardIndex = ShardOf(hash);
+	const auto &shard = shards[shardIndex];
+
+	std::shared_lock lock(shard.mutex);
+	const auto id = shard.interner.Find(str, hash);
+	return id == notInterned ? id : Encode(shardIndex, id);
+}
+
+template<typename HashPolicy>
+auto SharedInterner<HashPolicy>::Size() const -> size_t
+{
+	size_t size = 0;
+	for (const auto &shard : shards)
+	{
+		std::shared_lock lock(shard.mutex);
+		size += shard.interner.Size();
+	}
+	return size;
+}
+
+template<typename HashPolicy>
+auto SharedInterner<HashPolicy>::Stats() const -> TableStats
+{
+	TableStats stats;
+	for (const auto &shard : shards)
+	{
+		std::shared_lock lock(shard.mutex);
+		stats += shard.interner.Stats();
+	}
+	return stats;
+}
+
+template<typename HashPolicy>
+auto SharedInterner<HashPolicy>::Freeze() -> void
+{
+	if (isFrozen)
+	{
+		return;
+	}
+
+	frozen.reserve(Size());
+	for (symbol_id_t shardIndex = 0; shardIndex < shardCount; ++shardIndex)
+	{
+		auto &shard = shards[shardIndex];
+		std::unique_lock lock(shard.mutex);
+
+		for (symbol_id_t index = 0; index < shard.interner.Size(); ++index)
+		{
+			const auto id = Encode(shardIndex, index);
+			frozen.push_back({ static_cast<std::uint32_t>(hasher(Get(id))), id });
+		}
+
+		shard.interner.DropTable();
+	}
+
+	std::sort(frozen.begin(), frozen.end(), [](const FrozenEntry &a, const FrozenEntry &b) {
+		return a.hash < b.hash;
+	});
+
+	isFrozen = true;
+}
+
+template<typename HashPolicy>
+auto SharedInterner<HashPolicy>::Frozen() const -> bool
+{
+	return isFrozen;
+}
+
+template class SharedInterner<MurmurHash>;
+template class SharedInterner<WyHash>;
+template class SharedInterner<Crc32cHash>;
+
+}
@@ -0,0 +1,181 @@
+/**
+ * @author ruarq
+ * @date 25.02.2022 
+ *
+ * Copyright (C) 2022 ruarq
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <shared_mutex>
+#include <string_view>
+#include <vector>
+
+#include "Interner.hpp"
+
+namespace Lm
+{
+
+/**
+ * @brief Thread safe interner.
+ *
+ * Strings are spread over shards by the top bits of their hash, every shard is an
+ * Interner behind its own lock. Looking up a string that's already interned only
+ * takes the shard lock shared, so threads only wait on each other while inserting
+ * into the same shard.
+ *
+ * The shard is encoded in the low bits of the id, which leaves 2^28 strings per
+ * shard. Ids are stable and the same for every thread.
+ *
+ * A list of strings can be reserved on construction, they get the ids 0, 1, 2, ...
+ * in the order of the list, no matter which shard they end up in.
+ *
+ * Once no new strings show up anymore the interner can be frozen. That replaces the
+ * hash tables of the shards with a single sorted array, which is searched without
+ * taking any locks.
+ *
+ * See Interner for HashPolicy. Only the low 32 bits of the hash are used, like in
+ * Interner, the top 4 of them select the shard.
+ */
+template<typename HashPolicy = DefaultHash>
+class SharedInterner final
+{
+public:
+	static constexpr size_t shardBits = 4;
+	static constexpr size_t shardCount = size_t(1) << shardBits;
+
+public:
+	/**
+	 * @brief Create the interner with the reserved strings already in it, the strings
+	 * have to be unique
+	 */
+	explicit SharedInterner(const std::vector<std::string_view> &reserved = {},
+		const HashPolicy &hasher = HashPolicy());
+
+public:
+	/**
+	 * @brief Get the id of a string, adds the string if it's new
+	 */
+	auto Intern(const std::string_view str) -> symbol_id_t;
+
+	/**
+	 * @brief Same as Intern(str), with the hash of str already computed (the low 32
+	 * bits of the hash the policy gives)
+	 */
+	auto Intern(const std::string_view str, const std::uint32_t hash) -> symbol_id_t;
+
+	/**
+	 * @brief Get the id of a string without adding it
+	 * @return The id or notInterned
+	 */
+	auto Find(const std::string_view str) const -> symbol_id_t;
+
+	/**
+	 * @brief Get the string of an id, doesn't lock
+	 */
+	inline auto Get(const symbol_id_t id) const -> std::string_view
+	{
+		const auto reservedCount = static_cast<symbol_id_t>(reservedLocal.size());
+		const auto local = id < reservedCount ? reservedLocal[id] : id - reservedCount;
+		return shards[local & (shardCount - 1)].interner.Get(local >> shardBits);
+	}
+
+	/**
+	 * @brief Number of strings
+	 */
+	auto Size() const -> size_t;
+
+	/**
+	 * @brief Measure the hash tables of all shards, empty once frozen
+	 */
+	auto Stats() const -> TableStats;
+
+	/**
+	 * @brief Build the read only lookup array and free the hash tables of the shards.
+	 * Intern() mustn't be called anymore after this, it returns notInterned.
+	 * Nothing else may use the interner while it's freezing.
+	 */
+	auto Freeze() -> void;
+
+	auto Frozen() const -> bool;
+
+	inline auto Hasher() const -> const HashPolicy &
+	{
+		return hasher;
+	}
+
+private:
+	/// Aligned so the locks of neighbouring shards don't share a cache line
+	struct alignas(64) Shard final
+	{
+		mutable std::shared_mutex mutex;
+		Interner<HashPolicy> interner;
+
+		/// Ids of the reserved strings, which are the first strings of the shard
+		std::vector<symbol_id_t> reserved;
+	};
+
+	struct FrozenEntry final
+	{
+		std::uint32_t hash;
+		symbol_id_t id;
+	};
+
+private:
+	static inline auto ShardOf(const std::uint32_t hash) -> symbol_id_t
+	{
+		return hash >> (32 - shardBits);
+	}
+
+	/**
+	 * @brief Get the id of the index-th string of a shard
+	 */
+	inline auto Encode(const symbol_id_t shardIndex, const symbol_id_t index) const -> symbol_id_t
+	{
+		const auto &reserved = shards[shardIndex].reserved;
+		if (index < reserved.size())
+		{
+			return reserved[index];
+		}
+
+		return static_cast<symbol_id_t>(reservedLocal.size()) + ((index << shardBits) | shardIndex);
+	}
+
+private:
+	std::array<Shard, shardCount> shards;
+
+	/// Shard and index in the shard of every reserved string, by id
+	std::vector<symbol_id_t> reservedLocal;
+
+	/// Every id sorted by the hash of its string, filled by Freeze()
+	std::vector<FrozenEntry> frozen;
+	bool isFrozen = false;
+
+	HashPolicy hasher;
+};
+
+extern template class SharedInterner<MurmurHash>;
+extern template class SharedInterner<WyHash>;
+extern template class SharedInterner<Crc32cHash>;
+
+}
@@ -26,44 +26,49 @@
 #pragma once
 
 #include <limits>
-#include <string>
-#include <unordered_map>
-#include <vector>
 
-#include "Hashes/MurmurHash.hpp"
+#include "Interner.hpp"
 
 namespace Lm
 {
 
-using symbol_id_t = unsigned long;
-
+/**
+ * @brief Handle of an interned string. The strings live in the symbol table of the
+ * CompilationSession, two symbols of the same session are equal if their strings are.
+ */
 class Symbol final
 {
 public:
 	static constexpr auto invalidId = std::numeric_limits<symbol_id_t>::max();
 
 public:
-	static auto NextId() -> symbol_id_t;
-
-	/**
-	 * @brief Frees the memory of the stringToId hashmap. We don't need it anymore after lexing.
-	 */
-	static auto DropHashmap() -> void;
+	constexpr Symbol() = default;
+	constexpr explicit Symbol(const symbol_id_t id)
+		: id(id)
+	{
+	}
 
 public:
-	static std::vector<std::string> pool;
-	static std::unordered_map<std::string, symbol_id_t, MurmurHash> stringToId;
+	constexpr auto Id() const -> symbol_id_t
+	{
+		return id;
+	}
 
 public:
-	Symbol() = default;
-	Symbol(std::string &&str);
+	constexpr auto operator==(const Symbol other) const -> bool
+	{
+		return id == other.id;
+	}
 
-public:
-	auto String() const -> const std::string &;
+	constexpr auto operator!=(const Symbol other) const -> bool
+	{
+		return id != other.id;
+	}
 
-public:
-	auto operator=(std::string &&str) -> Symbol &;
-	operator bool() const;
+	constexpr operator bool() const
+	{
+		return id != invalidId;
+	}
 
 private:
 	symbol_id_t id = invalidId;
@@ -0,0 +1,104 @@
+/**
+ * @author ruarq
+ * @date 05.03.2022 
+ *
+ * Copyright (C) 2022 ruarq
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include "ThreadPool.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace Lm
+{
+
+ThreadPool::ThreadPool(const size_t threads)
+{
+	workers.reserve(std::max<size_t>(threads, 1));
+	for (size_t i = 0; i < std::max<size_t>(threads, 1); ++i)
+	{
+		workers.emplace_back(&ThreadPool::Work, this);
+	}
+}
+
+ThreadPool::~ThreadPool()
+{
+	{
+		std::lock_guard lock(mutex);
+		stop = true;
+	}
+	wake.notify_all();
+
+	for (auto &worker : workers)
+	{
+		worker.join();
+	}
+}
+
+auto ThreadPool::Submit(Task task) -> void
+{
+	{
+		std::lock_guard lock(mutex);
+		tasks.push_back(std::move(task));
+	}
+	wake.notify_one();
+}
+
+auto ThreadPool::Wait() -> void
+{
+	std::unique_lock lock(mutex);
+	done.wait(lock, [this] { return tasks.empty() && running == 0; });
+}
+
+auto ThreadPool::Threads() const -> size_t
+{
+	return workers.size();
+}
+
+auto ThreadPool::Work() -> void
+{
+	std::unique_lock lock(mutex);
+	while (true)
+	{
+		wake.wait(lock, [this] { return stop || !tasks.empty(); });
+		if (tasks.empty())
+		{
+			// Stopping, and nothing left to do
+			return;
+		}
+
+		auto task = std::move(tasks.front());
+		tasks.pop_front();
+		++running;
+
+		lock.unlock();
+		task();
+		lock.lock();
+
+		if (--running == 0 && tasks.empty())
+		{
+			done.notify_all();
+		}
+	}
+}
+
+}
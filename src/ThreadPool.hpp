@@ -0,0 +1,84 @@
+/**
+ * @author ruarq
+ * @date 05.03.2022 
+ *
+ * Copyright (C) 2022 ruarq
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Lm
+{
+
+/**
+ * @brief Fixed number of worker threads taking tasks from a shared queue
+ */
+class ThreadPool final
+{
+public:
+	using Task = std::function<void()>;
+
+public:
+	explicit ThreadPool(const size_t threads);
+	ThreadPool(const ThreadPool &) = delete;
+	~ThreadPool();
+
+	auto operator=(const ThreadPool &) -> ThreadPool & = delete;
+
+public:
+	/**
+	 * @brief Queue a task, the first idle worker runs it
+	 */
+	auto Submit(Task task) -> void;
+
+	/**
+	 * @brief Block until every task submitted so far is done
+	 */
+	auto Wait() -> void;
+
+	/**
+	 * @brief Number of worker threads
+	 */
+	auto Threads() const -> size_t;
+
+private:
+	auto Work() -> void;
+
+private:
+	std::vector<std::thread> workers;
+
+	std::mutex mutex;
+	std::condition_variable wake;	 ///< Signaled when there's a task or the pool stops
+	std::condition_variable done;	 ///< Signaled when the last running task finishes
+	std::deque<Task> tasks;
+	size_t running = 0;
+	bool stop = false;
+};
+
+}
@@ -23,21 +23,40 @@
  * IN THE SOFTWARE.
  */
 
+#include <algorithm>
 #include <chrono>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <numeric>
+#include <optional>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include <fmt/chrono.h>
 #include <fmt/format.h>
 
+#include "Bench/Ast.hpp"
+#include "Bench/Hash.hpp"
+#include "Bench/Intern.hpp"
+#include "CompilationSession.hpp"
 #include "Diagnostics.hpp"
 #include "File.hpp"
+#include "Hashes/Seed.hpp"
 #include "Lexer/Lexer.hpp"
+#include "Lexer/Scan.hpp"
+#include "Lexer/TokenPipe.hpp"
 #include "Localization/Locale.hpp"
 #include "Logger.hpp"
 #include "Macros.hpp"
 #include "Opt/Parse.hpp"
+#include "Parser/LazyBodies.hpp"
+#include "Parser/ParallelParse.hpp"
 #include "Parser/Parser.hpp"
+#include "Prefetcher.hpp"
+#include "Scheduler.hpp"
+#include "ThreadPool.hpp"
 
 using namespace std::string_literals;
 
@@ -51,6 +70,89 @@ auto LoadLocale() -> void
 	Lm::Locale::LoadFromFile("data/locales/"s + locale);
 }
 
+/**
+ * @brief Compile files on jobs worker threads, the largest files first. The output of
+ * every file is held back and printed in the order of filenames.
+ * @return False if a file couldn't be loaded, the files after it print nothing
+ */
+auto CompileParallel(const std::vector<std::string> &filenames,
+	const std::function<bool(const std::string &)> &Compile,
+	const size_t jobs,
+	const bool benchmark) -> bool
+{
+	// A file that can't be read counts as empty, it fails as soon as it's loaded
+	std::vector<std::uintmax_t> sizes(filenames.size());
+	for (size_t i = 0; i < filenames.size(); ++i)
+	{
+		std::error_code error;
+		sizes[i] = std::filesystem::file_size(filenames[i], error);
+		if (error)
+		{
+			sizes[i] = 0;
+		}
+	}
+
+	// Big files go first, so none of them is left to run alone at the end
+	std::vector<size_t> order(filenames.size());
+	std::iota(order.begin(), order.end(), 0);
+	std::stable_sort(order.begin(), order.end(), [&sizes](const size_t a, const size_t b) {
+		return sizes[a] > sizes[b];
+	});
+
+	std::vector<Lm::LogBuffer> outputs(filenames.size());
+
+	// Not std::vector<bool>, the workers write their elements concurrently
+	std::vector<char> loaded(filenames.size(), false);
+
+	std::vector<Lm::Scheduler::Task> tasks;
+	tasks.reserve(order.size());
+	for (const auto i : order)
+	{
+		tasks.push_back([&, i] {
+			Lm::Logger::Redirect(&outputs[i]);
+			loaded[i] = Compile(filenames[i]);
+			Lm::Logger::Redirect(nullptr);
+		});
+	}
+
+	Lm::Scheduler scheduler(jobs);
+	scheduler.Run(std::move(tasks));
+
+	for (size_t i = 0; i < filenames.size(); ++i)
+	{
+		fmt::print("{}", outputs[i].Take());
+		if (!loaded[i])
+		{
+			return false;
+		}
+	}
+
+	if (benchmark)
+	{
+		const auto bytes = std::accumulate(sizes.begin(), sizes.end(), std::uintmax_t(0));
+		const auto elapsed = std::chrono::duration<double>(scheduler.Elapsed());
+		Lm::Logger::Info("jobs: - {} files - {:.2f} MiB in {} - {:.2f} MiB/s",
+			filenames.size(),
+			(double)bytes / (double)(1 << 20),
+			elapsed,
+			(double)bytes / (elapsed.count() * (double)(1 << 20)));
+
+		const auto &stats = scheduler.Stats();
+		for (size_t worker = 0; worker < stats.size(); ++worker)
+		{
+			const auto busy = std::chrono::duration<double>(stats[worker].busy);
+			Lm::Logger::Info("worker {}: - {} files ({} stolen) - busy {} - {:.1f}% utilization",
+				worker,
+				stats[worker].tasks,
+				stats[worker].steals,
+				busy,
+				100.0 * busy.count() / elapsed.count());
+		}
+	}
+
+	return true;
+}
+
 // TODO(ruarq): File a bug report about this, clang format formats
 // "auto main(int argc, char **argv) -> int"
 // to
@@ -68,6 +170,45 @@ int main(int argc, char **argv)
 	// Whether benchmarking should be done or not
 	bool benchmark = false;
 
+	// Maximum number of threads for the interner benchmark, 0 if it shouldn't run
+	size_t internBenchThreads = 0;
+
+	// Seed of the symbol table hash, random unless given or benchmarking
+	std::optional<std::uint64_t> seed;
+
+	// Whether the hash policies should be compared on the input files instead of compiling them
+	bool hashBench = false;
+
+	// Whether walking the pointer and the flat AST should be compared instead of compiling
+	bool astBench = false;
+
+	// Whether only the lexer should run (no parsing)
+	bool lexOnly = false;
+
+	// Whether files get tokenized completely before parsing
+	bool tokenStream = false;
+
+	// Whether the lexer runs on its own thread, ahead of the parser
+	bool pipeline = false;
+
+	// Whether function bodies are skipped by the parser and parsed on demand
+	bool lazyBodies = false;
+
+	// Threads parsing the declarations of a file in parallel, 0 to parse sequentially
+	size_t parseThreads = 0;
+
+	// Threads compiling different files in parallel, 0 to compile them one after another
+	size_t jobs = 0;
+
+	// Deepest nesting of blocks and expressions the parser accepts
+	size_t maxDepth = Lm::Parser::defaultMaxDepth;
+
+	// How the input files get loaded into memory
+	auto loadMode = Lm::File::LoadMode::Map;
+
+	// Bytes of input files loaded ahead on a background thread, 0 to load them when needed
+	size_t readAhead = 0;
+
 	const std::vector<Lm::Opt::Option> options = {
 	// clang-format off
 		{
@@ -99,6 +240,133 @@ int main(int argc, char **argv)
 			},
 			Lm::Locale::Get("HELP_BENCHMARK_DESCRIPTION")
 		},
+		{
+			"benchmark-intern",
+			Lm::Opt::Option::noShortOption,
+			Lm::Opt::Option::Argument::Optional,
+			[&internBenchThreads](const std::string &threads) {
+				internBenchThreads = threads.empty()
+					? std::max(std::thread::hardware_concurrency(), 1u)
+					: std::max(std::stoul(threads), 1ul);
+			},
+			Lm::Locale::Get("HELP_BENCHMARK_INTERN_DESCRIPTION")
+		},
+		{
+			"benchmark-hash",
+			Lm::Opt::Option::noShortOption,
+			Lm::Opt::Option::Argument::None,
+			[&hashBench](const std::string &) {
+				hashBench = true;
+			},
+			Lm::Locale::Get("HELP_BENCHMARK_HASH_DESCRIPTION")
+		},
+		{
+			"benchmark-ast",
+			Lm::Opt::Option::noShortOption,
+			Lm::Opt::Option::Argument::None,
+			[&astBench](const std::string &) {
+				astBench = true;
+			},
+			Lm::Locale::Get("HELP_BENCHMARK_AST_DESCRIPTION")
+		},
+		{
+			"seed",
+			Lm::Opt::Option::noShortOption,
+			Lm::Opt::Option::Argument::Required,
+			[&seed](const std::string &value) {
+				seed = std::stoull(value, nullptr, 0);
+			},
+			Lm::Locale::Get("HELP_SEED_DESCRIPTION")
+		},
+		{
+			"max-nesting",
+			Lm::Opt::Option::noShortOption,
+			Lm::Opt::Option::Argument::Required,
+			[&maxDepth](const std::string &value) {
+				maxDepth = std::max(std::stoul(value), 1ul);
+			},
+			Lm::Locale::Get("HELP_MAX_NESTING_DESCRIPTION")
+		},
+		{
+			"lazy-bodies",
+			Lm::Opt::Option::noShortOption,
+			Lm::Opt::Option::Argument::None,
+			[&lazyBodies](const std::string &) {
+				lazyBodies = true;
+			},
+			Lm::Locale::Get("HELP_LAZY_BODIES_DESCRIPTION")
+		},
+		{
+			"parse-threads",
+			Lm::Opt::Option::noShortOption,
+			Lm::Opt::Option::Argument::Required,
+			[&parseThreads](const std::string &threads) {
+				parseThreads = std::stoul(threads);
+				if (parseThreads == 0)
+				{
+					parseThreads = std::max(std::thread::hardware_concurrency(), 1u);
+				}
+			},
+			Lm::Locale::Get("HELP_PARSE_THREADS_DESCRIPTION")
+		},
+		{
+			"jobs",
+			'j',
+			Lm::Opt::Option::Argument::Required,
+			[&jobs](const std::string &threads) {
+				jobs = std::stoul(threads);
+				if (jobs == 0)
+				{
+					jobs = std::max(std::thread::hardware_concurrency(), 1u);
+				}
+			},
+			Lm::Locale::Get("HELP_JOBS_DESCRIPTION")
+		},
+		{
+			"no-mmap",
+			Lm::Opt::Option::noShortOption,
+			Lm::Opt::Option::Argument::None,
+			[&loadMode](const std::string &) {
+				loadMode = Lm::File::LoadMode::Read;
+			},
+			Lm::Locale::Get("HELP_NO_MMAP_DESCRIPTION")
+		},
+		{
+			"read-ahead",
+			Lm::Opt::Option::noShortOption,
+			Lm::Opt::Option::Argument::Required,
+			[&readAhead](const std::string &mebibytes) {
+				readAhead = std::stoul(mebibytes) << 20;
+			},
+			Lm::Locale::Get("HELP_READ_AHEAD_DESCRIPTION")
+		},
+		{
+			"lex-only",
+			Lm::Opt::Option::noShortOption,
+			Lm::Opt::Option::Argument::None,
+			[&lexOnly](const std::string &) {
+				lexOnly = true;
+			},
+			Lm::Locale::Get("HELP_LEX_ONLY_DESCRIPTION")
+		},
+		{
+			"token-stream",
+			Lm::Opt::Option::noShortOption,
+			Lm::Opt::Option::Argument::None,
+			[&tokenStream](const std::string &) {
+				tokenStream = true;
+			},
+			Lm::Locale::Get("HELP_TOKEN_STREAM_DESCRIPTION")
+		},
+		{
+			"pipeline",
+			Lm::Opt::Option::noShortOption,
+			Lm::Opt::Option::Argument::None,
+			[&pipeline](const std::string &) {
+				pipeline = true;
+			},
+			Lm::Locale::Get("HELP_PIPELINE_DESCRIPTION")
+		},
 		{
 			"help",
 			Lm::Opt::Option::noShortOption,
@@ -143,61 +411,314 @@ int main(int argc, char **argv)
 	auto filenames = Lm::Opt::Parse(std::vector<std::string>(argv, argv + argc), options);
 	RemoveDups(filenames);
 
+	// Benchmarks hash with a fixed seed, so the table layout is the same every run
+	if (!seed)
+	{
+		const auto anyBench = benchmark || internBenchThreads || hashBench || astBench;
+		seed = anyBench ? Lm::Seed::fixed : Lm::Seed::Random();
+	}
+
+	if (internBenchThreads)
+	{
+		Lm::Bench::Intern(internBenchThreads, *seed);
+		return 0;
+	}
+
+	if (hashBench)
+	{
+		Lm::Bench::Hash(filenames, *seed);
+		return 0;
+	}
+
+	if (astBench)
+	{
+		Lm::Bench::Ast(filenames, *seed);
+		return 0;
+	}
+
 	LM_DEBUG("Discovering {} file(s)...", filenames.size());
 
-	for (const auto &filename : filenames)
+	// The pool of parallel parsing can't tell the files compiled in parallel apart
+	if (jobs)
+	{
+		parseThreads = 0;
+	}
+
+	if (benchmark)
+	{
+		Lm::Logger::Info("lexer kernels: {}", Lm::Scan::Isa());
+		Lm::Logger::Info("hash seed: {:#x}", *seed);
+		if (parseThreads)
+		{
+			Lm::Logger::Info("parse threads: {}", parseThreads);
+		}
+		if (jobs)
+		{
+			Lm::Logger::Info("jobs: {}", jobs);
+		}
+	}
+
+	Lm::CompilationSession session(*seed);
+
+	// Parallel parsing splits the token stream and skipped bodies get parsed from it
+	// later, both need all tokens up front
+	std::optional<Lm::ThreadPool> pool;
+	if (parseThreads)
 	{
-		Lm::File file(filename);
+		pool.emplace(parseThreads);
+	}
+	tokenStream = tokenStream || parseThreads || lazyBodies;
+
+	// Files compiled in parallel load alongside each other anyway
+	std::optional<Lm::Prefetcher> prefetcher;
+	if (readAhead && !jobs)
+	{
+		prefetcher.emplace(filenames, loadMode, readAhead);
+	}
+
+	// Loads, lexes and parses one file, false if it can't be loaded. The prefetcher
+	// hands out the files in the order of filenames.
+	const auto Compile = [&](const std::string &filename) -> bool {
+		const auto loadStart = std::chrono::high_resolution_clock::now();
+		auto loaded = prefetcher ? prefetcher->Next() : nullptr;
+		if (!loaded)
+		{
+			loaded = std::make_unique<Lm::File>(filename, loadMode);
+		}
+		const auto &file = *loaded;
+		const auto loadEnd = std::chrono::high_resolution_clock::now();
 
 		if (!file.Buf())
 		{
 			// TODO(ruarq): Make fatal error out of this
-			Lm::Logger::Error(Lm::Locale::Get("FATAL_NO_SUCH_FILE_OR_DIRECTORY"), filename);
-			return 1;
+			const auto error =
+				file.TooLarge() ? "FATAL_FILE_TOO_LARGE" : "FATAL_NO_SUCH_FILE_OR_DIRECTORY";
+			Lm::Logger::Error(Lm::Locale::Get(error), filename);
+			return false;
 		}
 
 		/**
 		 * Lexing
 		 */
 		Lm::Diagnostics diagnostics(file);
-		Lm::Lexer lexer(file, diagnostics);
-		Lm::Parser parser(lexer, diagnostics);
+		Lm::Lexer<> lexer(file, diagnostics, session.Hasher());
+
+		if (lexOnly)
+		{
+			const auto start = std::chrono::high_resolution_clock::now();
+			size_t tokens = 0;
+			while (lexer.NextToken().type != Lm::Token::Type::Eof)
+			{
+				++tokens;
+			}
+			const auto end = std::chrono::high_resolution_clock::now();
+			const auto duration = std::chrono::duration<double>(end - start);
+
+			if (benchmark)
+			{
+				Lm::Logger::Info("{}: - lex {} - {} tokens - {:.2f} MiB/s",
+					file.Name(),
+					duration,
+					tokens,
+					(double)(file.Size()) / (duration.count() * (double)(1 << 20)));
+			}
+
+			return true;
+		}
+
+		/**
+		 * Parsing
+		 */
 		Lm::Ast::TranslationUnit *unit = nullptr;
+		const auto load = std::chrono::duration<double>(loadEnd - loadStart);
 
-		if (benchmark)
+		if (tokenStream)
 		{
 			const auto start = std::chrono::high_resolution_clock::now();
+			const auto stream = lexer.Tokenize();
+			const auto lexEnd = std::chrono::high_resolution_clock::now();
+
+			// Bodies reference the token stream, so they can't be parsed later than here
+			std::optional<Lm::LazyBodies> bodies;
+			if (lazyBodies)
 			{
+				bodies.emplace(stream, diagnostics, session, maxDepth);
+			}
+
+			// Skipping bodies leaves too little work to split up
+			if (pool && !bodies)
+			{
+				unit = Lm::ParseParallel(stream, diagnostics, session, *pool, maxDepth);
+			}
+			else
+			{
+				Lm::Parser parser(stream, diagnostics, session, maxDepth);
+				if (bodies)
+				{
+					parser.SkipBodies(*bodies);
+				}
 				unit = parser.Run();
 			}
 			const auto end = std::chrono::high_resolution_clock::now();
+
+			const auto lex = std::chrono::duration<double>(lexEnd - start);
+			const auto parse = std::chrono::duration<double>(end - lexEnd);
 			const auto duration = std::chrono::duration<double>(end - start);
 
-			Lm::Logger::Info("{}: - {} - {:.2f} MiB/s",
-				file.Name(),
-				duration,
-				(double)(file.Size()) / (duration.count() * (double)(1 << 20)));
+			if (benchmark)
+			{
+				Lm::Logger::Info("{}: - load {} ({}) - lex {} - parse {} - {} tokens - {:.2f} MiB/s",
+					file.Name(),
+					load,
+					file.Mapped() ? "mmap" : "read",
+					lex,
+					parse,
+					stream.Size(),
+					(double)(file.Size()) / (duration.count() * (double)(1 << 20)));
+			}
+
+			if (bodies)
+			{
+				// Nothing after the parser needs the bodies yet, parse them all so their
+				// diagnostics still show up
+				const auto bodiesStart = std::chrono::high_resolution_clock::now();
+				for (const auto stmt : unit->statements)
+				{
+					if (stmt && stmt->Is<Lm::Ast::FunctionDecl>())
+					{
+						static_cast<Lm::Ast::FunctionDecl *>(stmt)->Body();
+					}
+				}
+				const auto bodiesEnd = std::chrono::high_resolution_clock::now();
+
+				if (benchmark)
+				{
+					Lm::Logger::Info("{}: - signatures {} - {} bodies {}",
+						file.Name(),
+						std::chrono::duration<double>(end - lexEnd),
+						bodies->Parsed(),
+						std::chrono::duration<double>(bodiesEnd - bodiesStart));
+				}
+			}
 		}
-		else
+		else if (pipeline)
 		{
-			unit = parser.Run();
+			const auto start = std::chrono::high_resolution_clock::now();
+			Lm::TokenPipe pipe(lexer);
+			{
+				Lm::Parser parser(pipe, diagnostics, session, maxDepth);
+				unit = parser.Run();
+			}
+			pipe.Finish();
+			const auto end = std::chrono::high_resolution_clock::now();
+			const auto duration = std::chrono::duration<double>(end - start);
+
+			if (benchmark)
+			{
+				const auto lexerStalls = pipe.ProducerStalls();
+				const auto parserStalls = pipe.ConsumerStalls();
+				Lm::Logger::Info("{}: - load {} ({}) - parse {} - {:.2f} MiB/s",
+					file.Name(),
+					load,
+					file.Mapped() ? "mmap" : "read",
+					duration,
+					(double)(file.Size()) / (duration.count() * (double)(1 << 20)));
+				Lm::Logger::Info("{}: - {} batches - lexer stalls {} ({}) - parser stalls {} ({})",
+					file.Name(),
+					pipe.Batches(),
+					lexerStalls.count,
+					std::chrono::duration<double>(lexerStalls.time),
+					parserStalls.count,
+					std::chrono::duration<double>(parserStalls.time));
+			}
 		}
+		else
+		{
+			const auto start = std::chrono::high_resolution_clock::now();
+			{
+				Lm::Parser parser(lexer, diagnostics, session, maxDepth);
+				unit = parser.Run();
+			}
+			const auto end = std::chrono::high_resolution_clock::now();
+			const auto duration = std::chrono::duration<double>(end - start);
 
-		Lm::Symbol::DropHashmap();
+			if (benchmark)
+			{
+				Lm::Logger::Info("{}: - load {} ({}) - parse {} - {:.2f} MiB/s",
+					file.Name(),
+					load,
+					file.Mapped() ? "mmap" : "read",
+					duration,
+					(double)(file.Size()) / (duration.count() * (double)(1 << 20)));
+			}
+		}
 
+		// The whole tree goes with the arena of the translation unit
+		const auto ast = unit->arena.Stats();
+		const auto freeStart = std::chrono::high_resolution_clock::now();
 		delete unit;
+		const auto freeEnd = std::chrono::high_resolution_clock::now();
 
-		// {
-		// 	fmt::print("'{}' - {}\n",
-		// 		token.symbol ? token.symbol.String() : "No symbol",
-		// 		content.substr(token.offset, token.size));
-		// }
+		if (benchmark)
+		{
+			Lm::Logger::Info("{}: - ast {:.1f} KiB in {} allocations - {:.1f} KiB reserved in {} "
+							 "blocks - free {}",
+				file.Name(),
+				(double)ast.used / 1024.0,
+				ast.allocations,
+				(double)ast.reserved / 1024.0,
+				ast.blocks,
+				std::chrono::duration<double>(freeEnd - freeStart));
+		}
 
-		/**
-		 * Parsing
-		 */
-		// Lm::Parser parser;
-		// auto translationUnit = parser.Run(tokens);
+		return true;
+	};
+
+	if (jobs)
+	{
+		if (!CompileParallel(filenames, Compile, jobs, benchmark))
+		{
+			return 1;
+		}
+	}
+	else
+	{
+		for (const auto &filename : filenames)
+		{
+			if (!Compile(filename))
+			{
+				return 1;
+			}
+		}
+	}
+
+	if (prefetcher && benchmark)
+	{
+		const auto stats = prefetcher->Stats();
+		Lm::Logger::Info("read-ahead: - {} waits ({}) - peak {:.2f} MiB held",
+			stats.waits,
+			std::chrono::duration<double>(stats.time),
+			(double)stats.peak / (double)(1 << 20));
+	}
+
+	// The tables are gone after freezing
+	const auto stats = session.SymbolStats();
+
+	const auto freezeStart = std::chrono::high_resolution_clock::now();
+	session.Freeze();
+	const auto freezeEnd = std::chrono::high_resolution_clock::now();
+
+	if (benchmark)
+	{
+		Lm::Logger::Info("session: - {} symbols - freeze {}",
+			session.Symbols(),
+			std::chrono::duration<double>(freezeEnd - freezeStart));
+		Lm::Logger::Info("symbol table: - load factor {:.2f} - {} collisions - probe length {:.2f} "
+						 "average, {} max",
+			stats.LoadFactor(),
+			stats.collisions,
+			stats.AverageProbe(),
+			stats.maxProbe);
 	}
 
 	return 0;